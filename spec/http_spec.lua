@@ -0,0 +1,115 @@
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+local test = require 'luawt.test'
+
+-- Stand-in HTTP server: answers `requests` requests with
+-- "<request line>|<body>" and exits.
+local function startStandIn(port, requests)
+    test.runInBackground(([[
+        local socket = require 'socket'
+        local server = assert(socket.bind('127.0.0.1', %d))
+        server:settimeout(10)
+        for _ = 1, %d do
+            local client = server:accept()
+            if not client then
+                break
+            end
+            client:settimeout(5)
+            local request_line = client:receive('*l')
+            local length = 0
+            while true do
+                local line = client:receive('*l')
+                if not line or line == '' then
+                    break
+                end
+                local n = line:lower():match('^content%%-length: *(%%d+)')
+                length = tonumber(n) or length
+            end
+            local body = length > 0 and client:receive(length) or ''
+            local response = request_line .. '|' .. body
+            client:send(
+                'HTTP/1.0 200 OK\r\n' ..
+                'Content-Type: text/plain\r\n' ..
+                'X-Stand-In: yes\r\n' ..
+                'Content-Length: ' .. #response .. '\r\n\r\n' ..
+                response
+            )
+            client:close()
+        end
+    ]]):format(port, requests))
+    os.execute("sleep 1")
+end
+
+describe("luawt.http", function()
+
+    it("requests without blocking and defers rendering", function()
+        local luawt = require 'luawt'
+        local backend = 56790
+        startStandIn(backend, 2)
+        local server, _, data = test.getData(([[
+            local app, env = ...
+            local luawt = require 'luawt'
+            local text = luawt.WText('waiting', app:root())
+            local url = 'http://127.0.0.1:%d'
+            luawt.http.get(url .. '/hello', function(response, err)
+                luawt.Shared.get_result = response.body
+                luawt.Shared.get_header = response.headers['x-stand-in']
+                text:setText('got ' .. response.status)
+            end)
+            luawt.http.post(url .. '/form', 'a=1', function(response)
+                luawt.Shared.post_result = response.body
+            end, {headers = {['Content-Type'] = 'text/plain'}})
+        ]]):format(backend))
+        assert.truthy(data:match('got 200'))
+        assert.truthy(luawt.Shared.get_result:match('^GET /hello'))
+        assert.equal('yes', luawt.Shared.get_header)
+        assert.truthy(luawt.Shared.post_result:match('^POST /form'))
+        assert.truthy(luawt.Shared.post_result:match('|a=1$'))
+        test.clear(server)
+    end)
+
+    it("suspends a slot until the response", function()
+        local luawt = require 'luawt'
+        local backend = 56790
+        startStandIn(backend, 1)
+        local server, _, data = test.getData(([[
+            local app, env = ...
+            local luawt = require 'luawt'
+            local button = luawt.WPushButton(app:root())
+            button:clicked():connect(function()
+                local url = 'http://127.0.0.1:%d/slot'
+                local response, err = luawt.http.get(url)
+                button:setText('slot got ' .. response.status)
+            end)
+            button:clicked():emit()
+        ]]):format(backend))
+        assert.truthy(data:match('slot got 200'))
+        test.clear(server)
+    end)
+
+    it("reports errors to the callback", function()
+        local luawt = require 'luawt'
+        luawt.Shared.http_error = nil
+        local server, _, data = test.getData([[
+            local app, env = ...
+            local luawt = require 'luawt'
+            luawt.http.get('http://127.0.0.1:1/', function(response, e)
+                luawt.Shared.http_error = e
+            end, {timeout = 2})
+            luawt.WText('requested', app:root())
+        ]])
+        assert.truthy(data:match('requested'))
+        assert.truthy(luawt.Shared.http_error)
+        test.clear(server)
+    end)
+
+    it("requires a session", function()
+        local luawt = require 'luawt'
+        assert.has_error(function()
+            luawt.http.get('http://127.0.0.1/', function() end)
+        end)
+    end)
+
+end)
@@ -0,0 +1,52 @@
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+local test = require 'luawt.test'
+
+describe("luawt.jobs", function()
+
+    it("runs jobs in the pool and returns results to sessions", function()
+        local luawt = require 'luawt'
+        luawt.Shared.job_result = nil
+        luawt.Shared.job_error = nil
+        local server, _, data = test.getData([[
+            local app, env = ...
+            local luawt = require 'luawt'
+            luawt.jobs.submit('string', 'upper', 'hello', function(r, e)
+                luawt.Shared.job_result = r
+            end)
+            luawt.jobs.submit('string', 'no_such', '', function(r, e)
+                luawt.Shared.job_error = e
+            end)
+            luawt.WText('submitted', app:root())
+        ]])
+        assert.truthy(data:match('submitted'))
+        os.execute("sleep 1")
+        assert.equal('HELLO', luawt.Shared.job_result)
+        assert.truthy(luawt.Shared.job_error:match('no_such'))
+        test.clear(server)
+    end)
+
+    it("starts the pool once per server", function()
+        local luawt = require 'luawt'
+        -- the pool of the previous spec was stopped with its server
+        assert.equal(2, luawt.jobs.start(2))
+        assert.has_error(function()
+            luawt.jobs.start(3)
+        end)
+        local server = test.getData([[
+            local app, env = ...
+        ]])
+        test.clear(server)
+        assert.equal(3, luawt.jobs.start(3))
+    end)
+
+    it("requires a session to submit jobs", function()
+        local luawt = require 'luawt'
+        assert.has_error(function()
+            luawt.jobs.submit('string', 'upper', 'hello')
+        end)
+    end)
+
+end)
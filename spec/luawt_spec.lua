@@ -25,6 +25,38 @@ describe("luawt", function()
         test.clear(server, wt_config, false)
     end)
 
+    it("runs slots as #coroutines", function()
+        local code = [[
+            local app, env = ...
+            local luawt = require 'luawt'
+            local button = luawt.WPushButton(app:root())
+            button:clicked():connect(function()
+                luawt.sleep(0.2)
+                button:setText("woke up")
+            end)
+            button:clicked():emit()
+        ]]
+        local server, wt_config, data = test.getData(code)
+        assert.truthy(data:match('woke up'))
+        test.clear(server, wt_config, false)
+    end)
+
+    it("suspends only slots", function()
+        local luawt = require 'luawt'
+        assert.has_error(function()
+            luawt.sleep(0)
+        end)
+        local code = [[
+            local app, env = ...
+            local luawt = require 'luawt'
+            local ok = pcall(luawt.sleep, 0)
+            luawt.WText('sleep: ' .. tostring(ok), app:root())
+        ]]
+        local server, wt_config, data = test.getData(code)
+        assert.truthy(data:match('sleep: false'))
+        test.clear(server, wt_config, false)
+    end)
+
     it("#works fine with #WPushButton's set/isDefault", function()
         local code = [[
             local app, env = ...
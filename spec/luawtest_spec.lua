@@ -19,4 +19,27 @@ describe("luawtest", function()
         local button = luawtest.WPushButton(app:root())
         button:setText("кнопка")
     end)
+
+    it("finds inherited methods in own method table", function()
+        local luawtest = require 'luawtest'
+        local env = luawtest.WTestEnvironment()
+        local app = luawtest.MyApplication(env)
+        local button = luawtest.WPushButton(app:root())
+        local methods = getmetatable(button).__index
+        assert.truthy(rawget(methods, 'setText'))
+        -- inherited from WWidget
+        assert.truthy(rawget(methods, 'setStyleClass'))
+        button:setStyleClass('btn')
+    end)
+
+    it("passes large strings with zero bytes to WText", function()
+        local luawtest = require 'luawtest'
+        local env = luawtest.WTestEnvironment()
+        local app = luawtest.MyApplication(env)
+        local text = luawtest.WText(app:root())
+        text:setTextFormat('PlainText')
+        local str = ("текст\0"):rep(100000)
+        text:setText(str)
+        assert.equal(str, text:text())
+    end)
 end)
@@ -0,0 +1,61 @@
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+local test = require 'luawt.test'
+
+describe("luawt.main", function()
+
+    it("runs tasks of sessions in the main state", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                luawt.main.post('report', 'weekly', function(result, e)
+                    luawt.Shared.report = result or e
+                end)
+                luawt.WText('posted', app:root())
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+        })
+        server:addEntryPoint({
+            code = "require 'luawt'.main.post('stop', '')",
+            path = '/stop',
+        })
+        local calls = 0
+        luawt.main.handle('report', function(args)
+            calls = calls + 1
+            return 'report-' .. args
+        end)
+        luawt.main.handle('stop', function()
+            server:stop()
+        end)
+        luawt.Shared.report = nil
+        server:start()
+        os.execute("sleep 1")
+        test.runInBackground(([[
+            local http_client = require 'socket.http'
+            local url = 'http://127.0.0.1:%d'
+            http_client.request(url)
+            http_client.request(url)
+            os.execute('sleep 1')
+            http_client.request(url .. '/stop')
+        ]]):format(port))
+        local signal = server:run()
+        assert.is_nil(signal)
+        assert.truthy(calls >= 1 and calls <= 2)
+        assert.equal('report-weekly', luawt.Shared.report)
+    end)
+
+    it("requires a session to post tasks", function()
+        local luawt = require 'luawt'
+        assert.has_error(function()
+            luawt.main.post('report', 'weekly')
+        end)
+    end)
+
+end)
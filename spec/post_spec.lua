@@ -0,0 +1,56 @@
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+local test = require 'luawt.test'
+
+describe("luawt.post", function()
+
+    it("runs handlers in other sessions", function()
+        local luawt = require 'luawt'
+        luawt.Shared.pushed = nil
+        local server, _, data = test.getData([[
+            local app, env = ...
+            local luawt = require 'luawt'
+            luawt.handle('set', function(payload)
+                luawt.Shared.pushed = payload
+            end)
+            luawt.Shared.session = app:sessionId()
+            luawt.WText('handles', app:root())
+        ]])
+        assert.truthy(data:match('handles'))
+        local session = luawt.Shared.session
+        assert.equal(true, luawt.post(session, 'set', 'hello'))
+        os.execute("sleep 1")
+        assert.equal('hello', luawt.Shared.pushed)
+        assert.truthy(luawt.broadcast('set', 'everyone') >= 1)
+        os.execute("sleep 1")
+        assert.equal('everyone', luawt.Shared.pushed)
+        assert.equal(false, luawt.post('no-such-session', 'set', ''))
+        test.clear(server)
+    end)
+
+    it("registers handlers from slots", function()
+        local code = [[
+            local app, env = ...
+            local luawt = require 'luawt'
+            local button = luawt.WPushButton(app:root())
+            button:clicked():connect(function()
+                local ok = pcall(luawt.handle, 'set', function() end)
+                button:setText('handle: ' .. tostring(ok))
+            end)
+            button:clicked():emit()
+        ]]
+        local server, wt_config, data = test.getData(code)
+        assert.truthy(data:match('handle: true'))
+        test.clear(server, wt_config, false)
+    end)
+
+    it("requires a session to register handlers", function()
+        local luawt = require 'luawt'
+        assert.has_error(function()
+            luawt.handle('set', function() end)
+        end)
+    end)
+
+end)
@@ -0,0 +1,59 @@
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+describe("luawt.serialize", function()
+
+    local function roundtrip(value)
+        local luawt = require 'luawt'
+        return luawt.deserialize(luawt.serialize(value))
+    end
+
+    it("serializes values", function()
+        assert.equal(nil, roundtrip(nil))
+        assert.equal(true, roundtrip(true))
+        assert.equal(false, roundtrip(false))
+        assert.equal(42, roundtrip(42))
+        assert.equal(-7, roundtrip(-7))
+        assert.equal(0.5, roundtrip(0.5))
+        assert.equal('', roundtrip(''))
+        assert.equal('a\0b', roundtrip('a\0b'))
+        local t = {1, 2.5, 'three', {x = {y = false}}, [10] = 'ten'}
+        assert.same(t, roundtrip(t))
+    end)
+
+    it("serializes shared subtables", function()
+        local sub = {1}
+        assert.same({a = {1}, b = {1}}, roundtrip({a = sub, b = sub}))
+    end)
+
+    it("rejects cycles and functions", function()
+        local luawt = require 'luawt'
+        local t = {}
+        t.self = t
+        assert.has_error(function()
+            luawt.serialize(t)
+        end)
+        assert.has_error(function()
+            luawt.serialize({print})
+        end)
+        assert.has_error(function()
+            luawt.serialize(coroutine.create(print))
+        end)
+    end)
+
+    it("rejects malformed data", function()
+        local luawt = require 'luawt'
+        local data = luawt.serialize({a = 'long string'})
+        assert.has_error(function()
+            luawt.deserialize(data:sub(1, -3))
+        end)
+        assert.has_error(function()
+            luawt.deserialize(data .. 'x')
+        end)
+        assert.has_error(function()
+            luawt.deserialize('')
+        end)
+    end)
+
+end)
@@ -0,0 +1,517 @@
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+local test = require 'luawt.test'
+
+describe("luawt.WServer", function()
+
+    it("reports its #config", function()
+        local luawt = require 'luawt'
+        local server = luawt.WServer({
+            code = '',
+            ip = '127.0.0.1',
+            port = 56789,
+            threads = 2,
+            session_timeout = 60,
+            max_request_size = 256,
+            progressive_bootstrap = true,
+            web_sockets = false,
+        })
+        local config = server:config()
+        assert.equal(2, config.threads)
+        assert.equal(60, config.session_timeout)
+        assert.equal(256, config.max_request_size)
+        assert.equal(true, config.progressive_bootstrap)
+        assert.equal(false, config.web_sockets)
+        assert.equal('/usr/include/Wt', config.docroot)
+        -- config() returns a copy
+        config.threads = 100
+        assert.equal(2, server:config().threads)
+    end)
+
+    it("validates #options", function()
+        local luawt = require 'luawt'
+        local function make(options)
+            if options.code == nil then
+                options.code = ''
+            end
+            options.ip = '127.0.0.1'
+            options.port = 56789
+            return luawt.WServer(options)
+        end
+        assert.has_error(function()
+            make({no_such_option = 1})
+        end)
+        assert.has_error(function()
+            make({threads = 'many'})
+        end)
+        assert.has_error(function()
+            make({threads = 0})
+        end)
+        assert.has_error(function()
+            make({threads = 1.5})
+        end)
+        assert.has_error(function()
+            make({progressive_bootstrap = 'yes'})
+        end)
+        assert.has_error(function()
+            make({code = false})
+        end)
+        assert.has_error(function()
+            make({session_memory_limit = 4096, shared_states = 1})
+        end)
+        local wt_config = test.baseConfig()
+        assert.has_error(function()
+            make({wt_config = wt_config, session_timeout = 60})
+        end)
+        os.remove(wt_config)
+    end)
+
+    it("serves pages with #generated configuration", function()
+        local code = [[
+            local app, env = ...
+            local luawt = require 'luawt'
+            local text = luawt.WText(app:root())
+            text:setText("generated config")
+        ]]
+        local server, wt_config, data = test.getData(code)
+        assert.truthy(data:match('generated config'))
+        test.clear(server, wt_config)
+    end)
+
+    it("serves several #entry_points", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                luawt.WText(app:root()):setText("public site")
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+        })
+        server:addEntryPoint({
+            path = '/admin',
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                luawt.WText(app:root()):setText("admin site")
+            ]],
+        })
+        server:addEntryPoint({
+            path = '/widgets.js',
+            type = 'widgetset',
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                local text = luawt.WText()
+                text:setText("embedded")
+                app:bindWidget(text, 'embedded')
+            ]],
+        })
+        assert.has_error(function()
+            server:addEntryPoint({path = '/bad', code = '', type = 'x'})
+        end)
+        server:start()
+        os.execute("sleep 1")
+        assert.truthy(test.socketRequest(port):match('public site'))
+        local admin = test.socketRequest(port, '/admin')
+        assert.truthy(admin:match('admin site'))
+        assert.falsy(admin:match('public site'))
+        assert.truthy(test.socketRequest(port, '/widgets.js'))
+        assert.has_error(function()
+            server:addEntryPoint({path = '/late', code = ''})
+        end)
+        test.clear(server)
+    end)
+
+    it("serves Lua #resources", function()
+        local luawt = require 'luawt'
+        local http_client = require 'socket.http'
+        local port = 56789
+        local server = luawt.WServer({
+            ip = '127.0.0.1',
+            port = port,
+        })
+        server:addResource('/health', function(request, response)
+            response:setMimeType('application/json')
+            response:write('{"status": "ok", "method": "',
+                request.method, '"}')
+        end)
+        server:addResource('/csv', [[
+            return function(request, response)
+                local row = tonumber(request.continuation) or 1
+                if row == 1 then
+                    response:setMimeType('text/csv')
+                end
+                response:write('row', row, '\n')
+                if row < 3 then
+                    return row + 1
+                end
+            end
+        ]])
+        server:addResource('/echo', function(request, response)
+            response:write(request.params.x or '',
+                request:header('X-Test'))
+        end)
+        server:addResource('/broken', function(request, response)
+            error('broken handler')
+        end)
+        assert.has_error(function()
+            server:addResource('/syntax', '(;(;')
+        end)
+        server:start()
+        os.execute("sleep 1")
+        local health = test.socketRequest(port, '/health')
+        assert.truthy(health:match('"status": "ok"'))
+        assert.truthy(health:match('GET'))
+        local csv = test.socketRequest(port, '/csv')
+        assert.equal('row1\nrow2\nrow3\n', csv)
+        local echo = {}
+        http_client.request({
+            url = 'http://127.0.0.1:' .. port .. '/echo?x=param',
+            headers = {['X-Test'] = 'header'},
+            sink = require 'ltn12'.sink.table(echo),
+        })
+        assert.equal('paramheader', table.concat(echo))
+        local _, code = http_client.request(
+            'http://127.0.0.1:' .. port .. '/broken'
+        )
+        assert.equal(500, code)
+        test.clear(server)
+    end)
+
+    it("serves #static files from memory", function()
+        local luawt = require 'luawt'
+        local http_client = require 'socket.http'
+        local ltn12 = require 'ltn12'
+        local port = 56789
+        local dir = os.tmpname()
+        os.remove(dir)
+        os.execute("mkdir " .. dir)
+        local css = ('body { color: red; }\n'):rep(100)
+        local function writeCss(content)
+            local file = io.open(dir .. '/style.css', 'w')
+            file:write(content)
+            file:close()
+        end
+        writeCss(css)
+        local server = luawt.WServer({
+            ip = '127.0.0.1',
+            port = port,
+        })
+        server:addStaticResource('/static', {dir = dir, max_age = 60})
+        server:start()
+        os.execute("sleep 1")
+        local url = 'http://127.0.0.1:' .. port .. '/static/style.css'
+        local function get(headers)
+            local body = {}
+            local _, code, response_headers = http_client.request({
+                url = url,
+                headers = headers,
+                sink = ltn12.sink.table(body),
+            })
+            return table.concat(body), code, response_headers
+        end
+        local body, code, headers = get()
+        assert.equal(200, code)
+        assert.equal(css, body)
+        assert.equal('public, max-age=60', headers['cache-control'])
+        assert.truthy(headers['last-modified'])
+        local etag = headers['etag']
+        assert.truthy(etag)
+        local _, code = get({['If-None-Match'] = etag})
+        assert.equal(304, code)
+        local gzipped, code, headers = get({['Accept-Encoding'] = 'gzip'})
+        assert.equal(200, code)
+        assert.equal('gzip', headers['content-encoding'])
+        assert.truthy(#gzipped < #css)
+        -- representations differ, so their validators differ
+        assert.truthy(headers['etag'])
+        assert.not_equal(etag, headers['etag'])
+        local _, code = get({
+            ['Accept-Encoding'] = 'gzip',
+            ['If-None-Match'] = headers['etag'],
+        })
+        assert.equal(304, code)
+        -- changed file is served again
+        writeCss('p {}\n')
+        os.execute("sleep 1")
+        local body, code = get({['If-None-Match'] = etag})
+        assert.equal(200, code)
+        assert.equal('p {}\n', body)
+        local _, code = http_client.request(
+            'http://127.0.0.1:' .. port .. '/static/../etc/passwd'
+        )
+        assert.equal(404, code)
+        test.clear(server)
+        os.execute("rm -r " .. dir)
+    end)
+
+    it("#reloads code of applications", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local code = [[
+            local app, env = ...
+            local luawt = require 'luawt'
+            luawt.WText('version-%d', app:root())
+        ]]
+        local server = luawt.WServer({
+            code = code:format(1),
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+        })
+        server:addEntryPoint({
+            code = code:format(10),
+            path = '/admin',
+        })
+        server:start()
+        os.execute("sleep 1")
+        assert.truthy(test.socketRequest(port):match('version%-1'))
+        assert.equal(2, server:reload({code = code:format(2)}))
+        assert.truthy(test.socketRequest(port):match('version%-2'))
+        -- broken code doesn't replace working code
+        assert.has_error(function()
+            server:reload({code = '(;(;'})
+        end)
+        assert.truthy(test.socketRequest(port):match('version%-2'))
+        assert.has_error(function()
+            server:reload({code = '', path = '/no-such-path'})
+        end)
+        server:reload({code = code:format(11), path = '/admin'})
+        local admin = test.socketRequest(port, '/admin')
+        assert.truthy(admin:match('version%-11'))
+        assert.truthy(test.socketRequest(port):match('version%-2'))
+        test.clear(server)
+    end)
+
+    it("collects #metrics", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                luawt.Shared.visits = (luawt.Shared.visits or 0) + 1
+                luawt.WText('metrics', app:root())
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+            time_bindings = true,
+        })
+        server:addMetricsResource('/metrics')
+        local before = server:stats()
+        server:start()
+        os.execute("sleep 1")
+        for _ = 1, 3 do
+            test.socketRequest(port)
+        end
+        local stats = server:stats()
+        assert.equal(
+            3,
+            stats.sessions_created - before.sessions_created
+        )
+        assert.truthy(stats.sessions_live >= 3)
+        assert.equal(
+            3,
+            stats.session_create.count - before.session_create.count
+        )
+        assert.truthy(stats.binding.count > before.binding.count)
+        assert.truthy(stats.shared_lock.count > before.shared_lock.count)
+        assert.equal(26, #stats.event.buckets)
+        local text = test.socketRequest(port, '/metrics')
+        assert.truthy(text:match('luawt_sessions_created_total %d+'))
+        assert.truthy(text:match('luawt_slot_seconds_bucket{le="%+Inf"}'))
+        test.clear(server)
+    end)
+
+    it("limits creation of sessions per #client", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                luawt.WText('admitted', app:root())
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+            max_bootstraps = 4,
+            sessions_per_ip_rate = 0.001,
+            sessions_per_ip_burst = 2,
+        })
+        local before = server:stats().sessions_rejected
+        server:start()
+        os.execute("sleep 1")
+        assert.truthy(test.socketRequest(port):match('admitted'))
+        assert.truthy(test.socketRequest(port):match('admitted'))
+        local busy = test.socketRequest(port)
+        assert.falsy(busy:match('admitted'))
+        assert.truthy(busy:match('busy'))
+        assert.equal(1, server:stats().sessions_rejected - before)
+        test.clear(server)
+    end)
+
+    it("limits #memory of sessions", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                luawt.Shared.memory_limit = luawt.memory().limit
+                local ok = pcall(string.rep, 'x', 4 * 1024 * 1024)
+                luawt.Shared.big_string = tostring(ok)
+                luawt.WText('limited', app:root())
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+            session_memory_limit = 2048,
+        })
+        local before = server:stats().allocations_refused
+        server:start()
+        os.execute("sleep 1")
+        assert.truthy(test.socketRequest(port):match('limited'))
+        assert.equal(2048 * 1024, tonumber(luawt.Shared.memory_limit))
+        assert.equal('false', luawt.Shared.big_string)
+        assert.truthy(server:stats().allocations_refused > before)
+        assert.truthy(luawt.memory().used > 0)
+        test.clear(server)
+        -- a limit below the cost of opening the libraries
+        local ok, err = pcall(luawt.WServer, {
+            ip = '127.0.0.1',
+            port = port,
+            session_memory_limit = 1,
+        })
+        assert.falsy(ok)
+        assert.truthy(err:match('session_memory_limit'))
+    end)
+
+    it("collects #garbage of sessions after events", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        assert.has_error(function()
+            luawt.WServer({
+                ip = '127.0.0.1',
+                port = port,
+                gc_mode = 'manual',
+            })
+        end)
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                luawt.WText('collected', app:root())
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+            gc_defer_events = true,
+            gc_idle_step = 64,
+            gc_pause = 150,
+        })
+        local before = server:stats().gc_step.count
+        server:start()
+        os.execute("sleep 1")
+        assert.truthy(test.socketRequest(port):match('collected'))
+        -- the step runs in an event posted after the response
+        os.execute("sleep 1")
+        assert.truthy(server:stats().gc_step.count > before)
+        test.clear(server)
+    end)
+
+    it("runs sessions in #shared_states", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                visits = (visits or 0) + 1
+                luawt.Shared.visits = visits
+                local button = luawt.WPushButton(app:root())
+                button:clicked():connect(function()
+                    visits = visits + 1
+                end)
+                luawt.WText('shared state', app:root())
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+            shared_states = 1,
+        })
+        server:start()
+        os.execute("sleep 1")
+        assert.truthy(test.socketRequest(port):match('shared state'))
+        assert.truthy(test.socketRequest(port):match('shared state'))
+        -- globals of sessions are not shared
+        assert.equal('1', luawt.Shared.visits)
+        test.clear(server)
+    end)
+
+    it("aborts handlers exceeding #handler_instructions", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                while true do
+                end
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            handler_instructions = 100000,
+            handler_timeout = 5,
+        })
+        local before = server:stats().handlers_aborted
+        server:start()
+        os.execute("sleep 1")
+        test.socketRequest(port)
+        assert.equal(1, server:stats().handlers_aborted - before)
+        test.clear(server)
+    end)
+
+    it("#hibernates idle sessions", function()
+        local luawt = require 'luawt'
+        local port = 56789
+        local server = luawt.WServer({
+            code = [[
+                local app, env = ...
+                local luawt = require 'luawt'
+                local count = 0
+                luawt.onHibernate(function()
+                    return {count = count + 1}
+                end)
+                luawt.onResume(function(state)
+                    luawt.Shared.resumed_count = state.count
+                end)
+                luawt.Shared.hibernating_session = app:sessionId()
+                luawt.WText('hibernating', app:root())
+            ]],
+            ip = '127.0.0.1',
+            port = port,
+            progressive_bootstrap = true,
+            hibernate_after = 1,
+        })
+        local before = server:stats().sessions_hibernated
+        server:start()
+        os.execute("sleep 1")
+        assert.truthy(test.socketRequest(port):match('hibernating'))
+        os.execute("sleep 3")
+        assert.truthy(server:stats().sessions_hibernated > before)
+        -- the next request of the session wakes it up
+        luawt.Shared.resumed_count = nil
+        local id = luawt.Shared.hibernating_session
+        assert.truthy(test.socketRequest(port, '/?wtd=' .. id)
+            :match('hibernating'))
+        assert.equal(1, tonumber(luawt.Shared.resumed_count))
+        test.clear(server)
+    end)
+
+end)
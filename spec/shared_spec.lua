@@ -14,6 +14,61 @@ describe("luawt.Shared", function()
         assert.equal(luawt.Shared.test, nil)
     end)
 
+    it("stores tables", function()
+        local luawt = require 'luawt'
+        luawt.Shared.table = {1, 2, name = 'x', nested = {flag = true}}
+        assert.same({1, 2, name = 'x', nested = {flag = true}},
+            luawt.Shared.table)
+        luawt.Shared.table = nil
+        assert.has_error(function()
+            luawt.Shared.table = {print}
+        end)
+        assert.equal(luawt.Shared.table, nil)
+    end)
+
+    it("gets and sets many keys at once", function()
+        local luawt = require 'luawt'
+        luawt.SharedOps.setMany({
+            many1 = 'one',
+            many2 = 2,
+            many3 = 'three',
+        })
+        local values = luawt.SharedOps.getMany({'many1', 'many2', 'absent'})
+        assert.same({many1 = 'one', many2 = '2'}, values)
+        luawt.SharedOps.setMany({many1 = false})
+        assert.equal(luawt.Shared.many1, nil)
+        assert.equal(luawt.Shared.many3, 'three')
+        luawt.SharedOps.setMany({many2 = false, many3 = false})
+    end)
+
+    it("scans keys by prefix", function()
+        local luawt = require 'luawt'
+        luawt.SharedOps.setMany({
+            ['tile.a'] = '1',
+            ['tile.b'] = '2',
+            ['tilf'] = '3',
+            ['til'] = '4',
+        })
+        assert.same({['tile.a'] = '1', ['tile.b'] = '2'},
+            luawt.SharedOps.scan('tile.'))
+        assert.same({}, luawt.SharedOps.scan('none.'))
+        luawt.SharedOps.setMany({
+            ['tile.a'] = false,
+            ['tile.b'] = false,
+            ['tilf'] = false,
+            ['til'] = false,
+        })
+    end)
+
+    it("stores keys named like bulk functions", function()
+        local luawt = require 'luawt'
+        assert.equal(luawt.Shared.scan, nil)
+        luawt.Shared.scan = 'data'
+        assert.equal(luawt.Shared.scan, 'data')
+        assert.equal(type(luawt.SharedOps.scan), 'function')
+        luawt.Shared.scan = nil
+    end)
+
     it("syncs from child thread", function()
         local luawt = require 'luawt'
         luawt.Shared.foo = "bar"
@@ -28,3 +83,38 @@ describe("luawt.Shared", function()
     end)
 
 end)
+
+describe("luawt.SharedMemory", function()
+
+    it("shares Shared between #processes", function()
+        local luawt = require 'luawt'
+        local name = 'luawt_spec_' .. os.time()
+        local size = 1024 * 1024
+        local processes = 4
+        test.runProcesses(([[
+            local luawt = require 'luawt'
+            luawt.SharedMemory.open(%q, %d)
+            luawt.SharedOps.setMany({['proc.%%d'] = '%%d'})
+            for i = 1, 100 do
+                luawt.Shared['counter.%%d'] = tostring(i)
+            end
+        ]]):format(name, size), processes)
+        luawt.Shared.before_shm = 'local'
+        luawt.SharedMemory.open(name, size)
+        assert.equal(nil, luawt.Shared.before_shm)
+        finally(function()
+            luawt.SharedMemory.close()
+        end)
+        local procs = luawt.SharedOps.scan('proc.')
+        assert.equal(processes, test.sizeOf(procs))
+        for i = 1, processes do
+            assert.equal(tostring(i), procs['proc.' .. i])
+            assert.equal('100', luawt.Shared['counter.' .. i])
+        end
+        assert.truthy(luawt.SharedMemory.remove(name))
+        luawt.SharedMemory.close()
+        assert.equal('local', luawt.Shared.before_shm)
+        luawt.Shared.before_shm = nil
+    end)
+
+end)
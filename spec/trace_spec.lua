@@ -0,0 +1,30 @@
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+local test = require 'luawt.test'
+
+describe("luawt.Trace", function()
+
+    it("exports spans of sessions and bindings", function()
+        local luawt = require 'luawt'
+        local empty = luawt.Trace.export()
+        assert.truthy(empty:match('^{"traceEvents":%['))
+        luawt.Trace.start(1024)
+        local server, _, data = test.getData([[
+            local app, env = ...
+            local luawt = require 'luawt'
+            luawt.WText('traced', app:root())
+        ]])
+        assert.truthy(data:match('traced'))
+        luawt.Trace.stop()
+        local json = luawt.Trace.export(true)
+        assert.truthy(json:match('"cat":"session_create"'))
+        assert.truthy(json:match('"name":"luawt_WText_make"'))
+        assert.truthy(json:match('"ph":"X"'))
+        -- the buffer was cleared
+        assert.falsy(luawt.Trace.export():match('session_create'))
+        test.clear(server)
+    end)
+
+end)
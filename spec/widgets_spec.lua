@@ -140,4 +140,33 @@ describe("luawt widgets", function()
         test.testWidget("WDatePicker", true)
     end)
 
+    it("calls methods bound by BIND_METHOD", function()
+        local code = [[
+            local app, env = ...
+            local luawt = require 'luawt'
+            local text = luawt.WText(app:root())
+            local changed = text:setText('bound')
+            text:setWordWrap(false)
+            text:setStyleClass('bound-class')
+            local ok, err = pcall(text.setText, text, {})
+            local result = luawt.WText(app:root())
+            result:setText(table.concat({
+                'text=' .. text:text(),
+                'changed=' .. tostring(changed),
+                'wrap=' .. tostring(text:wordWrap()),
+                'class=' .. text:styleClass(),
+                'ok=' .. tostring(ok),
+                'err=' .. tostring(err),
+            }, ';'))
+        ]]
+        local server, wt_config, data = test.getData(code)
+        assert.truthy(data:match('text=bound;'))
+        assert.truthy(data:match('changed=true;'))
+        assert.truthy(data:match('wrap=false;'))
+        assert.truthy(data:match('class=bound%-class;'))
+        assert.truthy(data:match('ok=false;'))
+        assert.truthy(data:match('Wrong arguments for WText%.setText'))
+        test.clear(server, wt_config, false)
+    end)
+
 end)
@@ -48,8 +48,7 @@ int luawt_MyApplication_requireJQuery(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_requireJQuery_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         bool l_result = self->requireJQuery(url);
         lua_pushboolean(L, l_result);
         return 1;
@@ -65,10 +64,9 @@ int luawt_MyApplication_makeAbsoluteUrl(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_makeAbsoluteUrl_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         std::string l_result = self->makeAbsoluteUrl(url);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.makeAbsoluteUrl");
@@ -83,7 +81,7 @@ int luawt_MyApplication_bodyClass(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->bodyClass();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.bodyClass");
@@ -116,8 +114,7 @@ int luawt_MyApplication_addAutoJavaScript(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_addAutoJavaScript_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string javascript = std::string(raw2);
+        std::string javascript = luawt_toStdString(L, 2);
         self->addAutoJavaScript(javascript);
         return 0;
     } else {
@@ -132,8 +129,7 @@ int luawt_MyApplication_setTitle(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setTitle_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString title = Wt::WString(raw2);
+        Wt::WString title = luawt_toWString(L, 2);
         self->setTitle(title);
         return 0;
     } else {
@@ -148,8 +144,7 @@ int luawt_MyApplication_redirect(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_redirect_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         self->redirect(url);
         return 0;
     } else {
@@ -181,7 +176,7 @@ int luawt_MyApplication_docType(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->docType();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.docType");
@@ -211,13 +206,11 @@ int luawt_MyApplication_setInternalPath(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setInternalPath_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         self->setInternalPath(path);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         bool emitChange = lua_toboolean(L, 3);
         self->setInternalPath(path, emitChange);
         return 0;
@@ -279,7 +272,7 @@ int luawt_MyApplication_relativeResourcesUrl(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->relativeResourcesUrl();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.relativeResourcesUrl");
@@ -293,8 +286,7 @@ int luawt_MyApplication_setHtmlClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setHtmlClass_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string styleClass = std::string(raw2);
+        std::string styleClass = luawt_toStdString(L, 2);
         self->setHtmlClass(styleClass);
         return 0;
     } else {
@@ -339,8 +331,7 @@ int luawt_MyApplication_internalPathMatches(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_internalPathMatches_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         bool l_result = self->internalPathMatches(path);
         lua_pushboolean(L, l_result);
         return 1;
@@ -372,8 +363,7 @@ int luawt_MyApplication_setBodyClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setBodyClass_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string styleClass = std::string(raw2);
+        std::string styleClass = luawt_toStdString(L, 2);
         self->setBodyClass(styleClass);
         return 0;
     } else {
@@ -420,8 +410,7 @@ int luawt_MyApplication_removeMetaHeader(lua_State* L) {
                     2,
                     "Wrong enum type in args of MyApplication.removeMetaHeader"
                 ));
-        char const* raw3 = lua_tostring(L, 3);
-        std::string name = std::string(raw3);
+        std::string name = luawt_toStdString(L, 3);
         self->removeMetaHeader(type, name);
         return 0;
     } else {
@@ -454,19 +443,14 @@ int luawt_MyApplication_addMetaHeader(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_addMetaHeader_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString content = Wt::WString(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        Wt::WString content = luawt_toWString(L, 3);
         self->addMetaHeader(name, content);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString content = Wt::WString(raw3);
-        char const* raw4 = lua_tostring(L, 4);
-        std::string lang = std::string(raw4);
+        std::string name = luawt_toStdString(L, 2);
+        Wt::WString content = luawt_toWString(L, 3);
+        std::string lang = luawt_toStdString(L, 4);
         self->addMetaHeader(name, content, lang);
         return 0;
     } else if (index == 2) {
@@ -477,10 +461,8 @@ int luawt_MyApplication_addMetaHeader(lua_State* L) {
                     2,
                     "Wrong enum type in args of MyApplication.addMetaHeader"
                 ));
-        char const* raw3 = lua_tostring(L, 3);
-        std::string name = std::string(raw3);
-        char const* raw4 = lua_tostring(L, 4);
-        Wt::WString content = Wt::WString(raw4);
+        std::string name = luawt_toStdString(L, 3);
+        Wt::WString content = luawt_toWString(L, 4);
         self->addMetaHeader(type, name, content);
         return 0;
     } else if (index == 3) {
@@ -491,12 +473,9 @@ int luawt_MyApplication_addMetaHeader(lua_State* L) {
                     2,
                     "Wrong enum type in args of MyApplication.addMetaHeader"
                 ));
-        char const* raw3 = lua_tostring(L, 3);
-        std::string name = std::string(raw3);
-        char const* raw4 = lua_tostring(L, 4);
-        Wt::WString content = Wt::WString(raw4);
-        char const* raw5 = lua_tostring(L, 5);
-        std::string lang = std::string(raw5);
+        std::string name = luawt_toStdString(L, 3);
+        Wt::WString content = luawt_toWString(L, 4);
+        std::string lang = luawt_toStdString(L, 5);
         self->addMetaHeader(type, name, content, lang);
         return 0;
     } else {
@@ -541,7 +520,7 @@ int luawt_MyApplication_title(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->title();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.title");
@@ -556,7 +535,7 @@ int luawt_MyApplication_onePixelGifUrl(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->onePixelGifUrl();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.onePixelGifUrl");
@@ -571,7 +550,7 @@ int luawt_MyApplication_sessionId(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->sessionId();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.sessionId");
@@ -587,8 +566,7 @@ int luawt_MyApplication_bindWidget(lua_State* L) {
     if (index == 0) {
         Wt::WWidget* widget =
             luawt_checkFromLua<Wt::WWidget>(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string domId = std::string(raw3);
+        std::string domId = luawt_toStdString(L, 3);
         self->bindWidget(widget, domId);
         return 0;
     } else {
@@ -604,7 +582,7 @@ int luawt_MyApplication_javaScriptClass(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->javaScriptClass();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.javaScriptClass");
@@ -620,24 +598,18 @@ int luawt_MyApplication_removeCookie(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_removeCookie_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         self->removeCookie(name);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string domain = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string domain = luawt_toStdString(L, 3);
         self->removeCookie(name, domain);
         return 0;
     } else if (index == 2) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string domain = std::string(raw3);
-        char const* raw4 = lua_tostring(L, 4);
-        std::string path = std::string(raw4);
+        std::string name = luawt_toStdString(L, 2);
+        std::string domain = luawt_toStdString(L, 3);
+        std::string path = luawt_toStdString(L, 4);
         self->removeCookie(name, domain, path);
         return 0;
     } else {
@@ -670,45 +642,32 @@ int luawt_MyApplication_setCookie(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setCookie_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string value = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string value = luawt_toStdString(L, 3);
         int maxAge = lua_tointeger(L, 4);
         self->setCookie(name, value, maxAge);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string value = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string value = luawt_toStdString(L, 3);
         int maxAge = lua_tointeger(L, 4);
-        char const* raw5 = lua_tostring(L, 5);
-        std::string domain = std::string(raw5);
+        std::string domain = luawt_toStdString(L, 5);
         self->setCookie(name, value, maxAge, domain);
         return 0;
     } else if (index == 2) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string value = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string value = luawt_toStdString(L, 3);
         int maxAge = lua_tointeger(L, 4);
-        char const* raw5 = lua_tostring(L, 5);
-        std::string domain = std::string(raw5);
-        char const* raw6 = lua_tostring(L, 6);
-        std::string path = std::string(raw6);
+        std::string domain = luawt_toStdString(L, 5);
+        std::string path = luawt_toStdString(L, 6);
         self->setCookie(name, value, maxAge, domain, path);
         return 0;
     } else if (index == 3) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string value = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string value = luawt_toStdString(L, 3);
         int maxAge = lua_tointeger(L, 4);
-        char const* raw5 = lua_tostring(L, 5);
-        std::string domain = std::string(raw5);
-        char const* raw6 = lua_tostring(L, 6);
-        std::string path = std::string(raw6);
+        std::string domain = luawt_toStdString(L, 5);
+        std::string path = luawt_toStdString(L, 6);
         bool secure = lua_toboolean(L, 7);
         self->setCookie(name, value, maxAge, domain, path, secure);
         return 0;
@@ -740,24 +699,18 @@ int luawt_MyApplication_useStyleSheet(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_useStyleSheet_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
         self->useStyleSheet(link);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string media = std::string(raw3);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
+        std::string media = luawt_toStdString(L, 3);
         self->useStyleSheet(link, media);
         return 0;
     } else if (index == 2) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string condition = std::string(raw3);
-        char const* raw4 = lua_tostring(L, 4);
-        std::string media = std::string(raw4);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
+        std::string condition = luawt_toStdString(L, 3);
+        std::string media = luawt_toStdString(L, 4);
         self->useStyleSheet(link, condition, media);
         return 0;
     } else {
@@ -774,13 +727,12 @@ int luawt_MyApplication_bookmarkUrl(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->bookmarkUrl();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string internalPath = std::string(raw2);
+        std::string internalPath = luawt_toStdString(L, 2);
         std::string l_result = self->bookmarkUrl(internalPath);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.bookmarkUrl");
@@ -794,8 +746,7 @@ int luawt_MyApplication_findWidget(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_findWidget_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         Wt::WWidget* l_result = self->findWidget(name);
         luawt_toLua(L, l_result);
         return 1;
@@ -811,10 +762,9 @@ int luawt_MyApplication_resolveRelativeUrl(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_resolveRelativeUrl_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         std::string l_result = self->resolveRelativeUrl(url);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.resolveRelativeUrl");
@@ -829,7 +779,7 @@ int luawt_MyApplication_resourcesUrl(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->resourcesUrl();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.resourcesUrl");
@@ -907,16 +857,13 @@ int luawt_MyApplication_require(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_require_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         bool l_result = self->require(url);
         lua_pushboolean(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string symbol = std::string(raw3);
+        std::string url = luawt_toStdString(L, 2);
+        std::string symbol = luawt_toStdString(L, 3);
         bool l_result = self->require(url, symbol);
         lua_pushboolean(L, l_result);
         return 1;
@@ -932,8 +879,7 @@ int luawt_MyApplication_redirectToSession(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_redirectToSession_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string sessionId = std::string(raw2);
+        std::string sessionId = luawt_toStdString(L, 2);
         self->redirectToSession(sessionId);
         return 0;
     } else {
@@ -948,10 +894,8 @@ int luawt_MyApplication_pathMatches(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_pathMatches_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string query = std::string(raw3);
+        std::string path = luawt_toStdString(L, 2);
+        std::string query = luawt_toStdString(L, 3);
         bool l_result = self->pathMatches(path, query);
         lua_pushboolean(L, l_result);
         return 1;
@@ -967,8 +911,7 @@ int luawt_MyApplication_setCssTheme(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setCssTheme_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         self->setCssTheme(name);
         return 0;
     } else {
@@ -983,8 +926,7 @@ int luawt_MyApplication_removeMetaLink(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_removeMetaLink_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string href = std::string(raw2);
+        std::string href = luawt_toStdString(L, 2);
         self->removeMetaLink(href);
         return 0;
     } else {
@@ -1000,13 +942,11 @@ int luawt_MyApplication_doJavaScript(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_doJavaScript_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string javascript = std::string(raw2);
+        std::string javascript = luawt_toStdString(L, 2);
         self->doJavaScript(javascript);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string javascript = std::string(raw2);
+        std::string javascript = luawt_toStdString(L, 2);
         bool afterLoaded = lua_toboolean(L, 3);
         self->doJavaScript(javascript, afterLoaded);
         return 0;
@@ -1022,10 +962,9 @@ int luawt_MyApplication_encodeUntrustedUrl(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_encodeUntrustedUrl_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         std::string l_result = self->encodeUntrustedUrl(url);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.encodeUntrustedUrl");
@@ -1068,10 +1007,9 @@ int luawt_MyApplication_internalPathNextPart(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_internalPathNextPart_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         std::string l_result = self->internalPathNextPart(path);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.internalPathNextPart");
@@ -1106,8 +1044,7 @@ int luawt_MyApplication_setConfirmCloseMessage(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setConfirmCloseMessage_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString message = Wt::WString(raw2);
+        Wt::WString message = luawt_toWString(L, 2);
         self->setConfirmCloseMessage(message);
         return 0;
     } else {
@@ -1122,10 +1059,8 @@ int luawt_MyApplication_declareJavaScriptFunction(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_declareJavaScriptFunction_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string function = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string function = luawt_toStdString(L, 3);
         self->declareJavaScriptFunction(name, function);
         return 0;
     } else {
@@ -1140,8 +1075,7 @@ int luawt_MyApplication_setFocus(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setFocus_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string id = std::string(raw2);
+        std::string id = luawt_toStdString(L, 2);
         int selectionStart = lua_tointeger(L, 3);
         int selectionEnd = lua_tointeger(L, 4);
         self->setFocus(id, selectionStart, selectionEnd);
@@ -1190,10 +1124,9 @@ int luawt_MyApplication_internalSubPath(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_internalSubPath_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         std::string l_result = self->internalSubPath(path);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.internalSubPath");
@@ -1209,13 +1142,12 @@ int luawt_MyApplication_url(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->url();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string internalPath = std::string(raw2);
+        std::string internalPath = luawt_toStdString(L, 2);
         std::string l_result = self->url(internalPath);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.url");
@@ -1245,7 +1177,7 @@ int luawt_MyApplication_appRoot(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->appRoot();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.appRoot");
@@ -1333,7 +1265,7 @@ int luawt_MyApplication_internalPath(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->internalPath();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.internalPath");
@@ -1361,8 +1293,7 @@ int luawt_MyApplication_setJavaScriptClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_setJavaScriptClass_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string className = std::string(raw2);
+        std::string className = luawt_toStdString(L, 2);
         self->setJavaScriptClass(className);
         return 0;
     } else {
@@ -1392,18 +1323,12 @@ int luawt_MyApplication_addMetaLink(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_MyApplication_addMetaLink_args);
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string href = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string rel = std::string(raw3);
-        char const* raw4 = lua_tostring(L, 4);
-        std::string media = std::string(raw4);
-        char const* raw5 = lua_tostring(L, 5);
-        std::string hreflang = std::string(raw5);
-        char const* raw6 = lua_tostring(L, 6);
-        std::string type = std::string(raw6);
-        char const* raw7 = lua_tostring(L, 7);
-        std::string sizes = std::string(raw7);
+        std::string href = luawt_toStdString(L, 2);
+        std::string rel = luawt_toStdString(L, 3);
+        std::string media = luawt_toStdString(L, 4);
+        std::string hreflang = luawt_toStdString(L, 5);
+        std::string type = luawt_toStdString(L, 6);
+        std::string sizes = luawt_toStdString(L, 7);
         bool disabled = lua_toboolean(L, 8);
         self->addMetaLink(href, rel, media, hreflang, type, sizes, disabled);
         return 0;
@@ -1435,7 +1360,7 @@ int luawt_MyApplication_docRoot(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->docRoot();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.docRoot");
@@ -1465,7 +1390,7 @@ int luawt_MyApplication_htmlClass(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         std::string l_result = self->htmlClass();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.htmlClass");
@@ -1480,7 +1405,7 @@ int luawt_MyApplication_closeMessage(lua_State* L) {
     MyApplication* self = luawt_checkFromLua<MyApplication>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->closeMessage();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for MyApplication.closeMessage");
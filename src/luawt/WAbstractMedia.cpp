@@ -44,24 +44,18 @@ int luawt_WAbstractMedia_addSource(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAbstractMedia_addSource_args);
     WAbstractMedia* self = luawt_checkFromLua<WAbstractMedia>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink source = Wt::WLink(raw2);
+        Wt::WLink source = Wt::WLink(luawt_toStdString(L, 2));
         self->addSource(source);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink source = Wt::WLink(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string type = std::string(raw3);
+        Wt::WLink source = Wt::WLink(luawt_toStdString(L, 2));
+        std::string type = luawt_toStdString(L, 3);
         self->addSource(source, type);
         return 0;
     } else if (index == 2) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink source = Wt::WLink(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string type = std::string(raw3);
-        char const* raw4 = lua_tostring(L, 4);
-        std::string media = std::string(raw4);
+        Wt::WLink source = Wt::WLink(luawt_toStdString(L, 2));
+        std::string type = luawt_toStdString(L, 3);
+        std::string media = luawt_toStdString(L, 4);
         self->addSource(source, type, media);
         return 0;
     } else {
@@ -106,7 +100,7 @@ int luawt_WAbstractMedia_jsMediaRef(lua_State* L) {
     WAbstractMedia* self = luawt_checkFromLua<WAbstractMedia>(L, 1);
     if (index == 0) {
         std::string l_result = self->jsMediaRef();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAbstractMedia.jsMediaRef");
@@ -29,7 +29,7 @@ int luawt_WAbstractSpinBox_suffix(lua_State* L) {
     WAbstractSpinBox* self = luawt_checkFromLua<WAbstractSpinBox>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->suffix();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAbstractSpinBox.suffix");
@@ -43,8 +43,7 @@ int luawt_WAbstractSpinBox_setSuffix(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAbstractSpinBox_setSuffix_args);
     WAbstractSpinBox* self = luawt_checkFromLua<WAbstractSpinBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString suffix = Wt::WString(raw2);
+        Wt::WString suffix = luawt_toWString(L, 2);
         self->setSuffix(suffix);
         return 0;
     } else {
@@ -59,8 +58,7 @@ int luawt_WAbstractSpinBox_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAbstractSpinBox_setText_args);
     WAbstractSpinBox* self = luawt_checkFromLua<WAbstractSpinBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -76,7 +74,7 @@ int luawt_WAbstractSpinBox_prefix(lua_State* L) {
     WAbstractSpinBox* self = luawt_checkFromLua<WAbstractSpinBox>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->prefix();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAbstractSpinBox.prefix");
@@ -120,8 +118,7 @@ int luawt_WAbstractSpinBox_setPrefix(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAbstractSpinBox_setPrefix_args);
     WAbstractSpinBox* self = luawt_checkFromLua<WAbstractSpinBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString prefix = Wt::WString(raw2);
+        Wt::WString prefix = luawt_toWString(L, 2);
         self->setPrefix(prefix);
         return 0;
     } else {
@@ -14,7 +14,7 @@ int luawt_WAbstractToggleButton_text(lua_State* L) {
     WAbstractToggleButton* self = luawt_checkFromLua<WAbstractToggleButton>(L, 1);
     if (index == 0) {
         Wt::WString const l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAbstractToggleButton.text");
@@ -28,8 +28,7 @@ int luawt_WAbstractToggleButton_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAbstractToggleButton_setText_args);
     WAbstractToggleButton* self = luawt_checkFromLua<WAbstractToggleButton>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -92,8 +91,7 @@ int luawt_WAbstractToggleButton_setValueText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAbstractToggleButton_setValueText_args);
     WAbstractToggleButton* self = luawt_checkFromLua<WAbstractToggleButton>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setValueText(text);
         return 0;
     } else {
@@ -109,7 +107,7 @@ int luawt_WAbstractToggleButton_valueText(lua_State* L) {
     WAbstractToggleButton* self = luawt_checkFromLua<WAbstractToggleButton>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->valueText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAbstractToggleButton.valueText");
@@ -28,7 +28,7 @@ int luawt_WAnchor_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WAnchor");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -38,52 +38,45 @@ int luawt_WAnchor_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink link = Wt::WLink(raw1);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 1));
         WAnchor* l_result = new WAnchor(link);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WAnchor");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink link = Wt::WLink(raw1);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 1));
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WAnchor* l_result = new WAnchor(link, parent);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 4) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink link = Wt::WLink(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 1));
+        Wt::WString text = luawt_toWString(L, 2);
         WAnchor* l_result = new WAnchor(link, text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WAnchor");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink link = Wt::WLink(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 1));
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 3);
         WAnchor* l_result = new WAnchor(link, text, parent);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 6) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink link = Wt::WLink(raw1);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 1));
         Wt::WImage* image =
             luawt_checkFromLua<Wt::WImage>(L, 2);
         WAnchor* l_result = new WAnchor(link, image);
@@ -92,12 +85,11 @@ int luawt_WAnchor_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WAnchor");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 7) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink link = Wt::WLink(raw1);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 1));
         Wt::WImage* image =
             luawt_checkFromLua<Wt::WImage>(L, 2);
         Wt::WContainerWidget* parent =
@@ -164,7 +156,7 @@ int luawt_WAnchor_text(lua_State* L) {
     WAnchor* self = luawt_checkFromLua<WAnchor>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAnchor.text");
@@ -178,8 +170,7 @@ int luawt_WAnchor_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAnchor_setText_args);
     WAnchor* self = luawt_checkFromLua<WAnchor>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -194,8 +185,7 @@ int luawt_WAnchor_setLink(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAnchor_setLink_args);
     WAnchor* self = luawt_checkFromLua<WAnchor>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
         self->setLink(link);
         return 0;
     } else {
@@ -232,7 +222,7 @@ int luawt_WAnchor_link(lua_State* L) {
     WAnchor* self = luawt_checkFromLua<WAnchor>(L, 1);
     if (index == 0) {
         Wt::WLink const& l_result = self->link();
-        lua_pushstring(L, l_result.url().c_str());
+        luawt_pushString(L, l_result.url());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAnchor.link");
@@ -261,8 +251,7 @@ int luawt_WAnchor_setRefInternalPath(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAnchor_setRefInternalPath_args);
     WAnchor* self = luawt_checkFromLua<WAnchor>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         self->setRefInternalPath(path);
         return 0;
     } else {
@@ -277,8 +266,7 @@ int luawt_WAnchor_setRef(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WAnchor_setRef_args);
     WAnchor* self = luawt_checkFromLua<WAnchor>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         self->setRef(url);
         return 0;
     } else {
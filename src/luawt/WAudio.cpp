@@ -19,7 +19,7 @@ int luawt_WAudio_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WAudio");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -41,7 +41,7 @@ int luawt_WAudio_jsAudioRef(lua_State* L) {
     WAudio* self = luawt_checkFromLua<WAudio>(L, 1);
     if (index == 0) {
         std::string l_result = self->jsAudioRef();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WAudio.jsAudioRef");
@@ -22,7 +22,7 @@ int luawt_WCheckBox_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WCheckBox");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -32,20 +32,18 @@ int luawt_WCheckBox_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WCheckBox* l_result = new WCheckBox(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WCheckBox");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WCheckBox* l_result = new WCheckBox(text, parent);
@@ -20,7 +20,7 @@ int luawt_WComboBox_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WComboBox");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -58,7 +58,7 @@ int luawt_WComboBox_itemText(lua_State* L) {
     if (index == 0) {
         int index = lua_tointeger(L, 2);
         Wt::WString const l_result = self->itemText(index);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WComboBox.itemText");
@@ -73,8 +73,7 @@ int luawt_WComboBox_setItemText(lua_State* L) {
     WComboBox* self = luawt_checkFromLua<WComboBox>(L, 1);
     if (index == 0) {
         int index = lua_tointeger(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString text = Wt::WString(raw3);
+        Wt::WString text = luawt_toWString(L, 3);
         self->setItemText(index, text);
         return 0;
     } else {
@@ -90,8 +89,7 @@ int luawt_WComboBox_insertItem(lua_State* L) {
     WComboBox* self = luawt_checkFromLua<WComboBox>(L, 1);
     if (index == 0) {
         int index = lua_tointeger(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString text = Wt::WString(raw3);
+        Wt::WString text = luawt_toWString(L, 3);
         self->insertItem(index, text);
         return 0;
     } else {
@@ -120,8 +118,7 @@ int luawt_WComboBox_addItem(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WComboBox_addItem_args);
     WComboBox* self = luawt_checkFromLua<WComboBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->addItem(text);
         return 0;
     } else {
@@ -137,14 +134,12 @@ int luawt_WComboBox_findText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WComboBox_findText_args);
     WComboBox* self = luawt_checkFromLua<WComboBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         int l_result = self->findText(text);
         lua_pushinteger(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::WFlags<Wt::MatchFlag> flags = static_cast<Wt::MatchFlag>(luawt_getEnum(
                     L,
                     luawt_enum_MatchFlag_str,
@@ -182,7 +177,7 @@ int luawt_WComboBox_currentText(lua_State* L) {
     WComboBox* self = luawt_checkFromLua<WComboBox>(L, 1);
     if (index == 0) {
         Wt::WString const l_result = self->currentText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WComboBox.currentText");
@@ -241,8 +236,7 @@ int luawt_WComboBox_setValueText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WComboBox_setValueText_args);
     WComboBox* self = luawt_checkFromLua<WComboBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString value = Wt::WString(raw2);
+        Wt::WString value = luawt_toWString(L, 2);
         self->setValueText(value);
         return 0;
     } else {
@@ -273,7 +267,7 @@ int luawt_WComboBox_valueText(lua_State* L) {
     WComboBox* self = luawt_checkFromLua<WComboBox>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->valueText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WComboBox.valueText");
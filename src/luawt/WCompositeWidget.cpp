@@ -24,7 +24,7 @@ int luawt_WCompositeWidget_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WCompositeWidget");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -67,8 +67,7 @@ int luawt_WCompositeWidget_doJavaScript(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_doJavaScript_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string js = std::string(raw2);
+        std::string js = luawt_toStdString(L, 2);
         self->doJavaScript(js);
         return 0;
     } else {
@@ -131,8 +130,7 @@ int luawt_WCompositeWidget_find(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_find_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         Wt::WWidget* l_result = self->find(name);
         luawt_toLua(L, l_result);
         return 1;
@@ -227,7 +225,7 @@ int luawt_WCompositeWidget_styleClass(lua_State* L) {
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->styleClass();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WCompositeWidget.styleClass");
@@ -242,7 +240,7 @@ int luawt_WCompositeWidget_id(lua_State* L) {
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
         std::string const l_result = self->id();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WCompositeWidget.id");
@@ -525,10 +523,9 @@ int luawt_WCompositeWidget_attributeValue(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_attributeValue_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         Wt::WString l_result = self->attributeValue(name);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WCompositeWidget.attributeValue");
@@ -578,10 +575,9 @@ int luawt_WCompositeWidget_javaScriptMember(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_javaScriptMember_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         std::string l_result = self->javaScriptMember(name);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WCompositeWidget.javaScriptMember");
@@ -611,7 +607,7 @@ int luawt_WCompositeWidget_toolTip(lua_State* L) {
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->toolTip();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WCompositeWidget.toolTip");
@@ -740,8 +736,7 @@ int luawt_WCompositeWidget_setId(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_setId_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string id = std::string(raw2);
+        std::string id = luawt_toStdString(L, 2);
         self->setId(id);
         return 0;
     } else {
@@ -772,8 +767,7 @@ int luawt_WCompositeWidget_hasStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_hasStyleClass_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool l_result = self->hasStyleClass(styleClass);
         lua_pushboolean(L, l_result);
         return 1;
@@ -789,8 +783,7 @@ int luawt_WCompositeWidget_findById(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_findById_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         Wt::WWidget* l_result = self->findById(name);
         luawt_toLua(L, l_result);
         return 1;
@@ -822,13 +815,11 @@ int luawt_WCompositeWidget_setToolTip(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_setToolTip_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setToolTip(text);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -865,10 +856,8 @@ int luawt_WCompositeWidget_setJavaScriptMember(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_setJavaScriptMember_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string value = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string value = luawt_toStdString(L, 3);
         self->setJavaScriptMember(name, value);
         return 0;
     } else {
@@ -884,13 +873,11 @@ int luawt_WCompositeWidget_removeStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_removeStyleClass_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->removeStyleClass(styleClass);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool force = lua_toboolean(L, 3);
         self->removeStyleClass(styleClass, force);
         return 0;
@@ -920,8 +907,7 @@ int luawt_WCompositeWidget_setStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_setStyleClass_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->setStyleClass(styleClass);
         return 0;
     } else {
@@ -982,13 +968,11 @@ int luawt_WCompositeWidget_addStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_addStyleClass_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->addStyleClass(styleClass);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool force = lua_toboolean(L, 3);
         self->addStyleClass(styleClass, force);
         return 0;
@@ -1004,10 +988,8 @@ int luawt_WCompositeWidget_setAttributeValue(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_setAttributeValue_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString value = Wt::WString(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        Wt::WString value = luawt_toWString(L, 3);
         self->setAttributeValue(name, value);
         return 0;
     } else {
@@ -1022,10 +1004,8 @@ int luawt_WCompositeWidget_callJavaScriptMember(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WCompositeWidget_callJavaScriptMember_args);
     WCompositeWidget* self = luawt_checkFromLua<WCompositeWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string args = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string args = luawt_toStdString(L, 3);
         self->callJavaScriptMember(name, args);
         return 0;
     } else {
@@ -21,7 +21,7 @@ int luawt_WDateEdit_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WDateEdit");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -42,8 +42,7 @@ int luawt_WDateEdit_setFormat(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WDateEdit_setFormat_args);
     WDateEdit* self = luawt_checkFromLua<WDateEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString format = Wt::WString(raw2);
+        Wt::WString format = luawt_toWString(L, 2);
         self->setFormat(format);
         return 0;
     } else {
@@ -74,7 +73,7 @@ int luawt_WDateEdit_format(lua_State* L) {
     WDateEdit* self = luawt_checkFromLua<WDateEdit>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->format();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WDateEdit.format");
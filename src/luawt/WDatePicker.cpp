@@ -27,7 +27,7 @@ int luawt_WDatePicker_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WDatePicker");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -45,7 +45,7 @@ int luawt_WDatePicker_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WDatePicker");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
@@ -67,7 +67,7 @@ int luawt_WDatePicker_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WDatePicker");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
@@ -123,7 +123,7 @@ int luawt_WDatePicker_format(lua_State* L) {
     WDatePicker* self = luawt_checkFromLua<WDatePicker>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->format();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WDatePicker.format");
@@ -137,8 +137,7 @@ int luawt_WDatePicker_setFormat(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WDatePicker_setFormat_args);
     WDatePicker* self = luawt_checkFromLua<WDatePicker>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString format = Wt::WString(raw2);
+        Wt::WString format = luawt_toWString(L, 2);
         self->setFormat(format);
         return 0;
     } else {
@@ -19,7 +19,7 @@ int luawt_WDefaultLoadingIndicator_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WDefaultLoadingIndicator");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else {
@@ -49,8 +49,7 @@ int luawt_WDefaultLoadingIndicator_setMessage(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WDefaultLoadingIndicator_setMessage_args);
     WDefaultLoadingIndicator* self = luawt_checkFromLua<WDefaultLoadingIndicator>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setMessage(text);
         return 0;
     } else {
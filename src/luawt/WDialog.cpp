@@ -192,7 +192,7 @@ int luawt_WDialog_windowTitle(lua_State* L) {
     WDialog* self = luawt_checkFromLua<WDialog>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->windowTitle();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WDialog.windowTitle");
@@ -265,8 +265,7 @@ int luawt_WDialog_setWindowTitle(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WDialog_setWindowTitle_args);
     WDialog* self = luawt_checkFromLua<WDialog>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString title = Wt::WString(raw2);
+        Wt::WString title = luawt_toWString(L, 2);
         self->setWindowTitle(title);
         return 0;
     } else {
@@ -311,8 +310,7 @@ int luawt_WDialog_setCaption(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WDialog_setCaption_args);
     WDialog* self = luawt_checkFromLua<WDialog>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString caption = Wt::WString(raw2);
+        Wt::WString caption = luawt_toWString(L, 2);
         self->setCaption(caption);
         return 0;
     } else {
@@ -358,7 +356,7 @@ int luawt_WDialog_caption(lua_State* L) {
     WDialog* self = luawt_checkFromLua<WDialog>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->caption();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WDialog.caption");
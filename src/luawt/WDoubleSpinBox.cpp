@@ -19,7 +19,7 @@ int luawt_WDoubleSpinBox_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WDoubleSpinBox");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
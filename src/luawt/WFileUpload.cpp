@@ -21,7 +21,7 @@ int luawt_WFileUpload_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WFileUpload");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -43,7 +43,7 @@ int luawt_WFileUpload_clientFileName(lua_State* L) {
     WFileUpload* self = luawt_checkFromLua<WFileUpload>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->clientFileName();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WFileUpload.clientFileName");
@@ -58,7 +58,7 @@ int luawt_WFileUpload_contentDescription(lua_State* L) {
     WFileUpload* self = luawt_checkFromLua<WFileUpload>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->contentDescription();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WFileUpload.contentDescription");
@@ -73,7 +73,7 @@ int luawt_WFileUpload_spoolFileName(lua_State* L) {
     WFileUpload* self = luawt_checkFromLua<WFileUpload>(L, 1);
     if (index == 0) {
         std::string l_result = self->spoolFileName();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WFileUpload.spoolFileName");
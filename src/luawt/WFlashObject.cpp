@@ -16,20 +16,18 @@ static const char* const* const luawt_WFlashObject_make_args[] = {WFlashObject_m
 int luawt_WFlashObject_make(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WFlashObject_make_args);
     if (index == 0) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string url = std::string(raw1);
+        std::string url = luawt_toStdString(L, 1);
         WFlashObject* l_result = new WFlashObject(url);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WFlashObject");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string url = std::string(raw1);
+        std::string url = luawt_toStdString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WFlashObject* l_result = new WFlashObject(url, parent);
@@ -63,10 +61,8 @@ int luawt_WFlashObject_setFlashVariable(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WFlashObject_setFlashVariable_args);
     WFlashObject* self = luawt_checkFromLua<WFlashObject>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString value = Wt::WString(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        Wt::WString value = luawt_toWString(L, 3);
         self->setFlashVariable(name, value);
         return 0;
     } else {
@@ -81,10 +77,8 @@ int luawt_WFlashObject_setFlashParameter(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WFlashObject_setFlashParameter_args);
     WFlashObject* self = luawt_checkFromLua<WFlashObject>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString value = Wt::WString(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        Wt::WString value = luawt_toWString(L, 3);
         self->setFlashParameter(name, value);
         return 0;
     } else {
@@ -118,7 +112,7 @@ int luawt_WFlashObject_jsFlashRef(lua_State* L) {
     WFlashObject* self = luawt_checkFromLua<WFlashObject>(L, 1);
     if (index == 0) {
         std::string l_result = self->jsFlashRef();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WFlashObject.jsFlashRef");
@@ -78,8 +78,7 @@ int luawt_WFormWidget_setEmptyText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WFormWidget_setEmptyText_args);
     WFormWidget* self = luawt_checkFromLua<WFormWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString emptyText = Wt::WString(raw2);
+        Wt::WString emptyText = luawt_toWString(L, 2);
         self->setEmptyText(emptyText);
         return 0;
     } else {
@@ -139,13 +138,11 @@ int luawt_WFormWidget_setToolTip(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WFormWidget_setToolTip_args);
     WFormWidget* self = luawt_checkFromLua<WFormWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setToolTip(text);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -168,7 +165,7 @@ int luawt_WFormWidget_emptyText(lua_State* L) {
     WFormWidget* self = luawt_checkFromLua<WFormWidget>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->emptyText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WFormWidget.emptyText");
@@ -182,8 +179,7 @@ int luawt_WFormWidget_setValueText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WFormWidget_setValueText_args);
     WFormWidget* self = luawt_checkFromLua<WFormWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString value = Wt::WString(raw2);
+        Wt::WString value = luawt_toWString(L, 2);
         self->setValueText(value);
         return 0;
     } else {
@@ -244,7 +240,7 @@ int luawt_WFormWidget_valueText(lua_State* L) {
     WFormWidget* self = luawt_checkFromLua<WFormWidget>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->valueText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WFormWidget.valueText");
@@ -266,8 +266,7 @@ int luawt_WGLWidget_injectJS(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WGLWidget_injectJS_args);
     WGLWidget* self = luawt_checkFromLua<WGLWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string jsString = std::string(raw2);
+        std::string jsString = luawt_toStdString(L, 2);
         self->injectJS(jsString);
         return 0;
     } else {
@@ -572,8 +571,7 @@ int luawt_WGLWidget_texImage2D(lua_State* L) {
                     6,
                     "Wrong enum type in args of WGLWidget.texImage2D"
                 ));
-        char const* raw7 = lua_tostring(L, 7);
-        std::string texture = std::string(raw7);
+        std::string texture = luawt_toStdString(L, 7);
         self->texImage2D(target, level, internalformat, format, type, texture);
         return 0;
     } else {
@@ -28,7 +28,7 @@ int luawt_WGoogleMap_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WGoogleMap");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -51,7 +51,7 @@ int luawt_WGoogleMap_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WGoogleMap");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
@@ -22,7 +22,7 @@ int luawt_WGroupBox_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WGroupBox");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -32,20 +32,18 @@ int luawt_WGroupBox_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString title = Wt::WString(raw1);
+        Wt::WString title = luawt_toWString(L, 1);
         WGroupBox* l_result = new WGroupBox(title);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WGroupBox");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString title = Wt::WString(raw1);
+        Wt::WString title = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WGroupBox* l_result = new WGroupBox(title, parent);
@@ -63,8 +61,7 @@ int luawt_WGroupBox_setTitle(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WGroupBox_setTitle_args);
     WGroupBox* self = luawt_checkFromLua<WGroupBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString title = Wt::WString(raw2);
+        Wt::WString title = luawt_toWString(L, 2);
         self->setTitle(title);
         return 0;
     } else {
@@ -94,7 +91,7 @@ int luawt_WGroupBox_title(lua_State* L) {
     WGroupBox* self = luawt_checkFromLua<WGroupBox>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->title();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WGroupBox.title");
@@ -15,24 +15,20 @@ static const char* const* const luawt_WIconPair_make_args[] = {WIconPair_make_ar
 int luawt_WIconPair_make(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WIconPair_make_args);
     if (index == 0) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string icon1URL = std::string(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        std::string icon2URL = std::string(raw2);
+        std::string icon1URL = luawt_toStdString(L, 1);
+        std::string icon2URL = luawt_toStdString(L, 2);
         WIconPair* l_result = new WIconPair(icon1URL, icon2URL);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WIconPair");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string icon1URL = std::string(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        std::string icon2URL = std::string(raw2);
+        std::string icon1URL = luawt_toStdString(L, 1);
+        std::string icon2URL = luawt_toStdString(L, 2);
         bool clickIsSwitch = lua_toboolean(L, 3);
         WIconPair* l_result = new WIconPair(icon1URL, icon2URL, clickIsSwitch);
         MyApplication* app = MyApplication::instance();
@@ -40,14 +36,12 @@ int luawt_WIconPair_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WIconPair");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string icon1URL = std::string(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        std::string icon2URL = std::string(raw2);
+        std::string icon1URL = luawt_toStdString(L, 1);
+        std::string icon2URL = luawt_toStdString(L, 2);
         bool clickIsSwitch = lua_toboolean(L, 3);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 4);
@@ -25,7 +25,7 @@ int luawt_WImage_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WImage");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -35,44 +35,38 @@ int luawt_WImage_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink imageLink = Wt::WLink(raw1);
+        Wt::WLink imageLink = Wt::WLink(luawt_toStdString(L, 1));
         WImage* l_result = new WImage(imageLink);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WImage");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink imageLink = Wt::WLink(raw1);
+        Wt::WLink imageLink = Wt::WLink(luawt_toStdString(L, 1));
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WImage* l_result = new WImage(imageLink, parent);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 4) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink imageLink = Wt::WLink(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString altText = Wt::WString(raw2);
+        Wt::WLink imageLink = Wt::WLink(luawt_toStdString(L, 1));
+        Wt::WString altText = luawt_toWString(L, 2);
         WImage* l_result = new WImage(imageLink, altText);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WImage");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WLink imageLink = Wt::WLink(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString altText = Wt::WString(raw2);
+        Wt::WLink imageLink = Wt::WLink(luawt_toStdString(L, 1));
+        Wt::WString altText = luawt_toWString(L, 2);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 3);
         WImage* l_result = new WImage(imageLink, altText, parent);
@@ -90,8 +84,7 @@ int luawt_WImage_setImageRef(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WImage_setImageRef_args);
     WImage* self = luawt_checkFromLua<WImage>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         self->setImageRef(url);
         return 0;
     } else {
@@ -107,7 +100,7 @@ int luawt_WImage_imageRef(lua_State* L) {
     WImage* self = luawt_checkFromLua<WImage>(L, 1);
     if (index == 0) {
         std::string const l_result = self->imageRef();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WImage.imageRef");
@@ -121,8 +114,7 @@ int luawt_WImage_setAlternateText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WImage_setAlternateText_args);
     WImage* self = luawt_checkFromLua<WImage>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setAlternateText(text);
         return 0;
     } else {
@@ -138,7 +130,7 @@ int luawt_WImage_imageLink(lua_State* L) {
     WImage* self = luawt_checkFromLua<WImage>(L, 1);
     if (index == 0) {
         Wt::WLink const& l_result = self->imageLink();
-        lua_pushstring(L, l_result.url().c_str());
+        luawt_pushString(L, l_result.url());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WImage.imageLink");
@@ -152,8 +144,7 @@ int luawt_WImage_setImageLink(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WImage_setImageLink_args);
     WImage* self = luawt_checkFromLua<WImage>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
         self->setImageLink(link);
         return 0;
     } else {
@@ -169,7 +160,7 @@ int luawt_WImage_alternateText(lua_State* L) {
     WImage* self = luawt_checkFromLua<WImage>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->alternateText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WImage.alternateText");
@@ -17,20 +17,18 @@ static const char* const* const luawt_WInPlaceEdit_make_args[] = {WInPlaceEdit_m
 int luawt_WInPlaceEdit_make(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WInPlaceEdit_make_args);
     if (index == 0) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WInPlaceEdit* l_result = new WInPlaceEdit(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WInPlaceEdit");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WInPlaceEdit* l_result = new WInPlaceEdit(text, parent);
@@ -68,7 +66,7 @@ int luawt_WInPlaceEdit_text(lua_State* L) {
     WInPlaceEdit* self = luawt_checkFromLua<WInPlaceEdit>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WInPlaceEdit.text");
@@ -82,8 +80,7 @@ int luawt_WInPlaceEdit_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WInPlaceEdit_setText_args);
     WInPlaceEdit* self = luawt_checkFromLua<WInPlaceEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -159,7 +156,7 @@ int luawt_WInPlaceEdit_emptyText(lua_State* L) {
     WInPlaceEdit* self = luawt_checkFromLua<WInPlaceEdit>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->emptyText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WInPlaceEdit.emptyText");
@@ -173,8 +170,7 @@ int luawt_WInPlaceEdit_setEmptyText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WInPlaceEdit_setEmptyText_args);
     WInPlaceEdit* self = luawt_checkFromLua<WInPlaceEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString emptyText = Wt::WString(raw2);
+        Wt::WString emptyText = luawt_toWString(L, 2);
         self->setEmptyText(emptyText);
         return 0;
     } else {
@@ -26,7 +26,7 @@ int luawt_WLabel_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WLabel");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -36,20 +36,18 @@ int luawt_WLabel_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WLabel* l_result = new WLabel(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WLabel");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WLabel* l_result = new WLabel(text, parent);
@@ -64,7 +62,7 @@ int luawt_WLabel_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WLabel");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
@@ -148,7 +146,7 @@ int luawt_WLabel_text(lua_State* L) {
     WLabel* self = luawt_checkFromLua<WLabel>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WLabel.text");
@@ -162,8 +160,7 @@ int luawt_WLabel_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WLabel_setText_args);
     WLabel* self = luawt_checkFromLua<WLabel>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
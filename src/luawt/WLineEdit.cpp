@@ -22,7 +22,7 @@ int luawt_WLineEdit_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WLineEdit");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -32,20 +32,18 @@ int luawt_WLineEdit_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString content = Wt::WString(raw1);
+        Wt::WString content = luawt_toWString(L, 1);
         WLineEdit* l_result = new WLineEdit(content);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WLineEdit");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString content = Wt::WString(raw1);
+        Wt::WString content = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WLineEdit* l_result = new WLineEdit(content, parent);
@@ -115,7 +113,7 @@ int luawt_WLineEdit_text(lua_State* L) {
     WLineEdit* self = luawt_checkFromLua<WLineEdit>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WLineEdit.text");
@@ -129,8 +127,7 @@ int luawt_WLineEdit_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WLineEdit_setText_args);
     WLineEdit* self = luawt_checkFromLua<WLineEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -206,7 +203,7 @@ int luawt_WLineEdit_selectedText(lua_State* L) {
     WLineEdit* self = luawt_checkFromLua<WLineEdit>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->selectedText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WLineEdit.selectedText");
@@ -235,8 +232,7 @@ int luawt_WLineEdit_setValueText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WLineEdit_setValueText_args);
     WLineEdit* self = luawt_checkFromLua<WLineEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString value = Wt::WString(raw2);
+        Wt::WString value = luawt_toWString(L, 2);
         self->setValueText(value);
         return 0;
     } else {
@@ -267,7 +263,7 @@ int luawt_WLineEdit_valueText(lua_State* L) {
     WLineEdit* self = luawt_checkFromLua<WLineEdit>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->valueText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WLineEdit.valueText");
@@ -32,7 +32,7 @@ int luawt_WMediaPlayer_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMediaPlayer");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -97,8 +97,7 @@ int luawt_WMediaPlayer_setTitle(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMediaPlayer_setTitle_args);
     WMediaPlayer* self = luawt_checkFromLua<WMediaPlayer>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString title = Wt::WString(raw2);
+        Wt::WString title = luawt_toWString(L, 2);
         self->setTitle(title);
         return 0;
     } else {
@@ -202,8 +201,7 @@ int luawt_WMediaPlayer_addSource(lua_State* L) {
                     2,
                     "Wrong enum type in args of WMediaPlayer.addSource"
                 ));
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WLink link = Wt::WLink(raw3);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 3));
         self->addSource(encoding, link);
         return 0;
     } else {
@@ -241,7 +239,7 @@ int luawt_WMediaPlayer_jsPlayerRef(lua_State* L) {
     WMediaPlayer* self = luawt_checkFromLua<WMediaPlayer>(L, 1);
     if (index == 0) {
         std::string l_result = self->jsPlayerRef();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMediaPlayer.jsPlayerRef");
@@ -508,7 +506,7 @@ int luawt_WMediaPlayer_getSource(lua_State* L) {
                     "Wrong enum type in args of WMediaPlayer.getSource"
                 ));
         Wt::WLink l_result = self->getSource(encoding);
-        lua_pushstring(L, l_result.url().c_str());
+        luawt_pushString(L, l_result.url());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMediaPlayer.getSource");
@@ -36,7 +36,7 @@ int luawt_WMenu_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenu");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -59,7 +59,7 @@ int luawt_WMenu_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenu");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
@@ -84,7 +84,7 @@ int luawt_WMenu_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenu");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
@@ -111,7 +111,7 @@ int luawt_WMenu_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenu");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 7) {
@@ -173,7 +173,7 @@ int luawt_WMenu_internalBasePath(lua_State* L) {
     WMenu* self = luawt_checkFromLua<WMenu>(L, 1);
     if (index == 0) {
         std::string const& l_result = self->internalBasePath();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMenu.internalBasePath");
@@ -188,18 +188,15 @@ int luawt_WMenu_addMenu(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenu_addMenu_args);
     WMenu* self = luawt_checkFromLua<WMenu>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::WMenu* menu =
             luawt_checkFromLua<Wt::WMenu>(L, 3);
         Wt::WMenuItem* l_result = self->addMenu(text, menu);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string iconPath = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString text = Wt::WString(raw3);
+        std::string iconPath = luawt_toStdString(L, 2);
+        Wt::WString text = luawt_toWString(L, 3);
         Wt::WMenu* menu =
             luawt_checkFromLua<Wt::WMenu>(L, 4);
         Wt::WMenuItem* l_result = self->addMenu(iconPath, text, menu);
@@ -217,8 +214,7 @@ int luawt_WMenu_addSectionHeader(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenu_addSectionHeader_args);
     WMenu* self = luawt_checkFromLua<WMenu>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->addSectionHeader(text);
         return 0;
     } else {
@@ -309,8 +305,7 @@ int luawt_WMenu_setInternalPathEnabled(lua_State* L) {
         self->setInternalPathEnabled();
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string basePath = std::string(raw2);
+        std::string basePath = luawt_toStdString(L, 2);
         self->setInternalPathEnabled(basePath);
         return 0;
     } else {
@@ -399,22 +394,19 @@ int luawt_WMenu_addItem(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenu_addItem_args);
     WMenu* self = luawt_checkFromLua<WMenu>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString label = Wt::WString(raw2);
+        Wt::WString label = luawt_toWString(L, 2);
         Wt::WMenuItem* l_result = self->addItem(label);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString label = Wt::WString(raw2);
+        Wt::WString label = luawt_toWString(L, 2);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 3);
         Wt::WMenuItem* l_result = self->addItem(label, contents);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString label = Wt::WString(raw2);
+        Wt::WString label = luawt_toWString(L, 2);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 3);
         Wt::WMenuItem::LoadPolicy policy = static_cast<Wt::WMenuItem::LoadPolicy>(luawt_getEnum(
@@ -428,28 +420,22 @@ int luawt_WMenu_addItem(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string iconPath = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString label = Wt::WString(raw3);
+        std::string iconPath = luawt_toStdString(L, 2);
+        Wt::WString label = luawt_toWString(L, 3);
         Wt::WMenuItem* l_result = self->addItem(iconPath, label);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 4) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string iconPath = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString label = Wt::WString(raw3);
+        std::string iconPath = luawt_toStdString(L, 2);
+        Wt::WString label = luawt_toWString(L, 3);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 4);
         Wt::WMenuItem* l_result = self->addItem(iconPath, label, contents);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string iconPath = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString label = Wt::WString(raw3);
+        std::string iconPath = luawt_toStdString(L, 2);
+        Wt::WString label = luawt_toWString(L, 3);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 4);
         Wt::WMenuItem::LoadPolicy policy = static_cast<Wt::WMenuItem::LoadPolicy>(luawt_getEnum(
@@ -627,8 +613,7 @@ int luawt_WMenu_setInternalBasePath(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenu_setInternalBasePath_args);
     WMenu* self = luawt_checkFromLua<WMenu>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string basePath = std::string(raw2);
+        std::string basePath = luawt_toStdString(L, 2);
         self->setInternalBasePath(basePath);
         return 0;
     } else {
@@ -21,20 +21,18 @@ static const char* const* const luawt_WMenuItem_make_args[] = {WMenuItem_make_ar
 int luawt_WMenuItem_make(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenuItem_make_args);
     if (index == 0) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString label = Wt::WString(raw1);
+        Wt::WString label = luawt_toWString(L, 1);
         WMenuItem* l_result = new WMenuItem(label);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenuItem");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString label = Wt::WString(raw1);
+        Wt::WString label = luawt_toWString(L, 1);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 2);
         WMenuItem* l_result = new WMenuItem(label, contents);
@@ -43,12 +41,11 @@ int luawt_WMenuItem_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenuItem");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString label = Wt::WString(raw1);
+        Wt::WString label = luawt_toWString(L, 1);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 2);
         Wt::WMenuItem::LoadPolicy policy = static_cast<Wt::WMenuItem::LoadPolicy>(luawt_getEnum(
@@ -64,28 +61,24 @@ int luawt_WMenuItem_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenuItem");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string iconPath = std::string(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString label = Wt::WString(raw2);
+        std::string iconPath = luawt_toStdString(L, 1);
+        Wt::WString label = luawt_toWString(L, 2);
         WMenuItem* l_result = new WMenuItem(iconPath, label);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenuItem");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 4) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string iconPath = std::string(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString label = Wt::WString(raw2);
+        std::string iconPath = luawt_toStdString(L, 1);
+        Wt::WString label = luawt_toWString(L, 2);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 3);
         WMenuItem* l_result = new WMenuItem(iconPath, label, contents);
@@ -94,14 +87,12 @@ int luawt_WMenuItem_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenuItem");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
-        char const* raw1 = lua_tostring(L, 1);
-        std::string iconPath = std::string(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString label = Wt::WString(raw2);
+        std::string iconPath = luawt_toStdString(L, 1);
+        Wt::WString label = luawt_toWString(L, 2);
         Wt::WWidget* contents =
             luawt_checkFromLua<Wt::WWidget>(L, 3);
         Wt::WMenuItem::LoadPolicy policy = static_cast<Wt::WMenuItem::LoadPolicy>(luawt_getEnum(
@@ -117,7 +108,7 @@ int luawt_WMenuItem_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WMenuItem");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else {
@@ -327,7 +318,7 @@ int luawt_WMenuItem_text(lua_State* L) {
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMenuItem.text");
@@ -431,8 +422,7 @@ int luawt_WMenuItem_setFromInternalPath(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenuItem_setFromInternalPath_args);
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         self->setFromInternalPath(path);
         return 0;
     } else {
@@ -448,7 +438,7 @@ int luawt_WMenuItem_link(lua_State* L) {
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
         Wt::WLink l_result = self->link();
-        lua_pushstring(L, l_result.url().c_str());
+        luawt_pushString(L, l_result.url());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMenuItem.link");
@@ -478,7 +468,7 @@ int luawt_WMenuItem_pathComponent(lua_State* L) {
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
         std::string l_result = self->pathComponent();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMenuItem.pathComponent");
@@ -514,7 +504,7 @@ int luawt_WMenuItem_icon(lua_State* L) {
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
         std::string l_result = self->icon();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMenuItem.icon");
@@ -543,8 +533,7 @@ int luawt_WMenuItem_setPathComponent(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenuItem_setPathComponent_args);
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         self->setPathComponent(path);
         return 0;
     } else {
@@ -559,8 +548,7 @@ int luawt_WMenuItem_setIcon(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenuItem_setIcon_args);
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         self->setIcon(path);
         return 0;
     } else {
@@ -575,8 +563,7 @@ int luawt_WMenuItem_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenuItem_setText_args);
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -621,8 +608,7 @@ int luawt_WMenuItem_setLink(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMenuItem_setLink_args);
     WMenuItem* self = luawt_checkFromLua<WMenuItem>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
         self->setLink(link);
         return 0;
     } else {
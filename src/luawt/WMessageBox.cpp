@@ -16,7 +16,7 @@ int luawt_WMessageBox_text(lua_State* L) {
     WMessageBox* self = luawt_checkFromLua<WMessageBox>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WMessageBox.text");
@@ -30,8 +30,7 @@ int luawt_WMessageBox_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMessageBox_setText_args);
     WMessageBox* self = luawt_checkFromLua<WMessageBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -61,8 +60,7 @@ int luawt_WMessageBox_addButton(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WMessageBox_addButton_args);
     WMessageBox* self = luawt_checkFromLua<WMessageBox>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::StandardButton result = static_cast<Wt::StandardButton>(luawt_getEnum(
                     L,
                     luawt_enum_StandardButton_str,
@@ -24,7 +24,7 @@ int luawt_WNavigationBar_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WNavigationBar");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -75,15 +75,12 @@ int luawt_WNavigationBar_setTitle(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WNavigationBar_setTitle_args);
     WNavigationBar* self = luawt_checkFromLua<WNavigationBar>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString title = Wt::WString(raw2);
+        Wt::WString title = luawt_toWString(L, 2);
         self->setTitle(title);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString title = Wt::WString(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WLink link = Wt::WLink(raw3);
+        Wt::WString title = luawt_toWString(L, 2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 3));
         self->setTitle(title, link);
         return 0;
     } else {
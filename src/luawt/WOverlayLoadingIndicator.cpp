@@ -22,49 +22,43 @@ int luawt_WOverlayLoadingIndicator_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WOverlayLoadingIndicator");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString styleClass = Wt::WString(raw1);
+        Wt::WString styleClass = luawt_toWString(L, 1);
         WOverlayLoadingIndicator* l_result = new WOverlayLoadingIndicator(styleClass);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WOverlayLoadingIndicator");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString styleClass = Wt::WString(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString backgroundStyleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 1);
+        Wt::WString backgroundStyleClass = luawt_toWString(L, 2);
         WOverlayLoadingIndicator* l_result = new WOverlayLoadingIndicator(styleClass, backgroundStyleClass);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WOverlayLoadingIndicator");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString styleClass = Wt::WString(raw1);
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString backgroundStyleClass = Wt::WString(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString textStyleClass = Wt::WString(raw3);
+        Wt::WString styleClass = luawt_toWString(L, 1);
+        Wt::WString backgroundStyleClass = luawt_toWString(L, 2);
+        Wt::WString textStyleClass = luawt_toWString(L, 3);
         WOverlayLoadingIndicator* l_result = new WOverlayLoadingIndicator(styleClass, backgroundStyleClass, textStyleClass);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WOverlayLoadingIndicator");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else {
@@ -94,8 +88,7 @@ int luawt_WOverlayLoadingIndicator_setMessage(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WOverlayLoadingIndicator_setMessage_args);
     WOverlayLoadingIndicator* self = luawt_checkFromLua<WOverlayLoadingIndicator>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setMessage(text);
         return 0;
     } else {
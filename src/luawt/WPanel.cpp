@@ -22,7 +22,7 @@ int luawt_WPanel_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WPanel");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -104,7 +104,7 @@ int luawt_WPanel_title(lua_State* L) {
     WPanel* self = luawt_checkFromLua<WPanel>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->title();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WPanel.title");
@@ -118,8 +118,7 @@ int luawt_WPanel_setTitle(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WPanel_setTitle_args);
     WPanel* self = luawt_checkFromLua<WPanel>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString title = Wt::WString(raw2);
+        Wt::WString title = luawt_toWString(L, 2);
         self->setTitle(title);
         return 0;
     } else {
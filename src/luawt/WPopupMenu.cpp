@@ -23,7 +23,7 @@ int luawt_WPopupMenu_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WPopupMenu");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -35,7 +35,7 @@ int luawt_WPopupMenu_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WPopupMenu");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else {
@@ -21,7 +21,7 @@ int luawt_WProgressBar_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WProgressBar");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -72,8 +72,7 @@ int luawt_WProgressBar_setValueStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WProgressBar_setValueStyleClass_args);
     WProgressBar* self = luawt_checkFromLua<WProgressBar>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string valueClass = std::string(raw2);
+        std::string valueClass = luawt_toStdString(L, 2);
         self->setValueStyleClass(valueClass);
         return 0;
     } else {
@@ -89,7 +88,7 @@ int luawt_WProgressBar_format(lua_State* L) {
     WProgressBar* self = luawt_checkFromLua<WProgressBar>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->format();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WProgressBar.format");
@@ -103,8 +102,7 @@ int luawt_WProgressBar_setFormat(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WProgressBar_setFormat_args);
     WProgressBar* self = luawt_checkFromLua<WProgressBar>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString format = Wt::WString(raw2);
+        Wt::WString format = luawt_toWString(L, 2);
         self->setFormat(format);
         return 0;
     } else {
@@ -120,7 +118,7 @@ int luawt_WProgressBar_text(lua_State* L) {
     WProgressBar* self = luawt_checkFromLua<WProgressBar>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WProgressBar.text");
@@ -24,7 +24,7 @@ int luawt_WPushButton_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WPushButton");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -34,20 +34,18 @@ int luawt_WPushButton_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WPushButton* l_result = new WPushButton(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WPushButton");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WPushButton* l_result = new WPushButton(text, parent);
@@ -129,8 +127,7 @@ int luawt_WPushButton_setRef(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WPushButton_setRef_args);
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         self->setRef(url);
         return 0;
     } else {
@@ -168,7 +165,7 @@ int luawt_WPushButton_valueText(lua_State* L) {
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->valueText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WPushButton.valueText");
@@ -212,8 +209,7 @@ int luawt_WPushButton_setLink(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WPushButton_setLink_args);
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
         self->setLink(link);
         return 0;
     } else {
@@ -243,8 +239,7 @@ int luawt_WPushButton_setValueText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WPushButton_setValueText_args);
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString value = Wt::WString(raw2);
+        Wt::WString value = luawt_toWString(L, 2);
         self->setValueText(value);
         return 0;
     } else {
@@ -260,7 +255,7 @@ int luawt_WPushButton_ref(lua_State* L) {
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
         std::string l_result = self->ref();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WPushButton.ref");
@@ -289,8 +284,7 @@ int luawt_WPushButton_setIcon(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WPushButton_setIcon_args);
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WLink link = Wt::WLink(raw2);
+        Wt::WLink link = Wt::WLink(luawt_toStdString(L, 2));
         self->setIcon(link);
         return 0;
     } else {
@@ -321,7 +315,7 @@ int luawt_WPushButton_link(lua_State* L) {
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
         Wt::WLink const& l_result = self->link();
-        lua_pushstring(L, l_result.url().c_str());
+        luawt_pushString(L, l_result.url());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WPushButton.link");
@@ -357,7 +351,7 @@ int luawt_WPushButton_icon(lua_State* L) {
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
         Wt::WLink l_result = self->icon();
-        lua_pushstring(L, l_result.url().c_str());
+        luawt_pushString(L, l_result.url());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WPushButton.icon");
@@ -386,8 +380,7 @@ int luawt_WPushButton_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WPushButton_setText_args);
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         bool l_result = self->setText(text);
         lua_pushboolean(L, l_result);
         return 1;
@@ -418,7 +411,7 @@ int luawt_WPushButton_text(lua_State* L) {
     WPushButton* self = luawt_checkFromLua<WPushButton>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WPushButton.text");
@@ -22,7 +22,7 @@ int luawt_WRadioButton_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WRadioButton");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -32,20 +32,18 @@ int luawt_WRadioButton_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WRadioButton* l_result = new WRadioButton(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WRadioButton");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WRadioButton* l_result = new WRadioButton(text, parent);
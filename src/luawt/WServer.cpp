@@ -4,8 +4,14 @@
  * See the LICENSE file for terms of use.
  */
 
-#include <string>
+#include <cmath>
+#include <cstdlib>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
 
 #include "boost-xtime.hpp"
 #include <Wt/WEnvironment>
@@ -13,134 +19,906 @@
 #include <Wt/WIOService>
 
 #include "globals.hpp"
+#include "metrics.hpp"
+#include "server.hpp"
+#include "trace.hpp"
+
+/* Compiles code of an application, so syntax errors are reported
+   by the call which adds (or reloads) the code, and sessions load
+   bytecode instead of parsing the code again.
+*/
+static std::string luawt_compileApp(lua_State* L, const std::string& code) {
+    int status = luaL_loadbuffer(L, code.c_str(), code.size(), "app");
+    checkPcallStatus(L, status);
+    std::string bytecode = luawt_dumpFunction(L);
+    lua_pop(L, 1); // chunk
+    return bytecode;
+}
+
+/* Calls luawt_Admission::leave() on scope exit. */
+class luawt_AdmissionGuard {
+public:
+    luawt_AdmissionGuard(luawt_Admission& admission):
+        admission_(admission) {
+    }
+
+    ~luawt_AdmissionGuard() {
+        admission_.leave();
+    }
+
+private:
+    luawt_Admission& admission_;
+};
 
 class luawt_AppCreator {
 public:
-    luawt_AppCreator(void* shared, const std::string& code):
-        shared_(shared), code_(code) {
+    luawt_AppCreator(
+        void* shared,
+        AppCodePtr code,
+        AdmissionPtr admission,
+        const luawt_AppOptions& options,
+        StatePoolPtr states
+    ):
+        shared_(shared), code_(code), admission_(admission),
+        options_(options), states_(states) {
     }
 
     WApplication* operator()(const WEnvironment& env) const {
+        if (!admission_->enabled()) {
+            return create(env);
+        }
+        if (!admission_->enter(env.clientAddress())) {
+            return admission_->busyApplication(env);
+        }
+        luawt_AdmissionGuard guard(*admission_);
+        return create(env);
+    }
+
+private:
+    void* shared_;
+    AppCodePtr code_;
+    AdmissionPtr admission_;
+    luawt_AppOptions options_;
+    StatePoolPtr states_;
+
+    /* Like checkPcallStatus, but removes the error message:
+       the state may be shared with other sessions.
+    */
+    static void check(lua_State* L, int status) {
+        if (status != LUA_OK) {
+            const char* e = lua_tostring(L, -1);
+            std::string message = e ? e : "error in Lua";
+            lua_pop(L, 1);
+            throw std::logic_error(message);
+        }
+    }
+
+    WApplication* create(const WEnvironment& env) const {
+        luawt_Timer timer(METRIC_SESSION_CREATE);
+        luawt_TraceSpan span("session_create");
+        luawt_SharedState* state = states_ ? states_->choose() : 0;
         std::auto_ptr<MyApplication> app(
-            new MyApplication(0, shared_, env)
+            new MyApplication(0, shared_, env, options_, state)
+        );
+        luawt_StateLock lock(state);
+        boost::shared_ptr<const std::string> bytecode = code_->get();
+        int status = app->runCode(
+            *bytecode,
+            state ? luawt_setSessionEnv : 0
         );
-        int status = luaL_loadstring(app->L(),
-                code_.c_str());
-        checkPcallStatus(app->L(), status);
-        luawt_toLua<MyApplication>(app->L(), &(*app));
-        WEnvironment& env_nonconst =
-            const_cast<WEnvironment&>(env);
-        luawt_toLua<WEnvironment>(app->L(), &env_nonconst);
-        status = lua_pcall(app->L(), 2, 0, 0);
-        checkPcallStatus(app->L(), status);
+        if (status != LUA_OK) {
+            luawt_count(COUNTER_SESSION_ERRORS);
+        }
+        check(app->L(), status);
+        // sessions of widget set entry points have no root()
+        if (options_.hibernate_after_ms && !state && app->root()) {
+            app->enableHibernation(bytecode);
+        }
         return app.release();
     }
+};
 
-private:
-    std::string code_;
-    void* shared_;
+enum OptionType {
+    OPTION_STRING, // string or number
+    OPTION_INT, // integer, not less than min
+    OPTION_NUMBER, // number, not less than min
+    OPTION_BOOL,
 };
 
-/** Creates the Wt application server
-    Argument 1 is table of options
-    Possible options: code, port, config.
+struct ServerOption {
+    const char* name;
+    OptionType type;
+    int min;
+    /* Command line option of wthttp, if any. */
+    const char* argument;
+    /* Parent element of the XML element, if any. */
+    const char* group;
+    /* Element of <application-settings>, if any. */
+    const char* element;
+};
+
+/* Options which have neither argument nor element are used by luawt.
+   Sizes are in kilobytes (like in wt_config.xml), timeouts in seconds.
 */
-int luawt_WServer_make(lua_State* L) {
+static const ServerOption luawt_server_options[] = {
+    {"code", OPTION_STRING, 0, 0, 0, 0},
+    {"ip", OPTION_STRING, 0, "--http-address", 0, 0},
+    {"port", OPTION_STRING, 0, "--http-port", 0, 0},
+    {"wt_config", OPTION_STRING, 0, "--config", 0, 0},
+    {"docroot", OPTION_STRING, 0, "--docroot", 0, 0},
+    {"approot", OPTION_STRING, 0, "--approot", 0, 0},
+    {"accesslog", OPTION_STRING, 0, "--accesslog", 0, 0},
+    {"threads", OPTION_INT, 1, "--threads", 0, 0},
+    {
+        "max_memory_request_size", OPTION_INT, 0,
+        "--max-memory-request-size", 0, 0
+    },
+    {
+        "session_timeout", OPTION_INT, 1,
+        0, "session-management", "timeout"
+    },
+    {
+        "server_push_timeout", OPTION_INT, 1,
+        0, "session-management", "server-push-timeout"
+    },
+    {
+        "reload_is_new_session", OPTION_BOOL, 0,
+        0, "session-management", "reload-is-new-session"
+    },
+    {"max_request_size", OPTION_INT, 0, 0, 0, "max-request-size"},
+    {"session_id_length", OPTION_INT, 16, 0, 0, "session-id-length"},
+    {"idle_timeout", OPTION_INT, 1, 0, 0, "idle-timeout"},
+    {"max_plain_sessions", OPTION_NUMBER, 0, 0, 0, "max-plain-sessions"},
+    {"progressive_bootstrap", OPTION_BOOL, 0, 0, 0, "progressive-bootstrap"},
+    {"web_sockets", OPTION_BOOL, 0, 0, 0, "web-sockets"},
+    {"ajax_puzzle", OPTION_BOOL, 0, 0, 0, "ajax-puzzle"},
+    {"behind_reverse_proxy", OPTION_BOOL, 0, 0, 0, "behind-reverse-proxy"},
+    {"log_file", OPTION_STRING, 0, 0, 0, "log-file"},
+    {"time_bindings", OPTION_BOOL, 0, 0, 0, 0},
+    {"max_bootstraps", OPTION_INT, 1, 0, 0, 0},
+    {"max_sessions", OPTION_INT, 1, 0, 0, 0},
+    {"sessions_per_ip_rate", OPTION_NUMBER, 0, 0, 0, 0},
+    {"sessions_per_ip_burst", OPTION_INT, 1, 0, 0, 0},
+    {"busy_refresh", OPTION_INT, 1, 0, 0, 0},
+    {"session_memory_limit", OPTION_INT, 0, 0, 0, 0},
+    {"gc_mode", OPTION_STRING, 0, 0, 0, 0},
+    {"gc_pause", OPTION_INT, 0, 0, 0, 0},
+    {"gc_stepmul", OPTION_INT, 0, 0, 0, 0},
+    {"gc_defer_events", OPTION_BOOL, 0, 0, 0, 0},
+    {"gc_idle_step", OPTION_INT, 0, 0, 0, 0},
+    {"shared_states", OPTION_INT, 1, 0, 0, 0},
+    {"hibernate_after", OPTION_NUMBER, 0, 0, 0, 0},
+    {"handler_instructions", OPTION_INT, 1, 0, 0, 0},
+    {"handler_timeout", OPTION_NUMBER, 0, 0, 0, 0},
+    {NULL, OPTION_STRING, 0, 0, 0, 0},
+};
+
+static const ServerOption* luawt_findServerOption(const char* name) {
+    for (const ServerOption* o = luawt_server_options; o->name; ++o) {
+        if (strcmp(o->name, name) == 0) {
+            return o;
+        }
+    }
+    return 0;
+}
+
+/* Checks the value at the top of the stack. */
+static void luawt_checkServerOption(
+    lua_State* L,
+    const ServerOption* option
+) {
+    int type = lua_type(L, -1);
+    std::string error = std::string("LuaWt: option '") +
+                        option->name + "' of WServer must be ";
+    if (option->type == OPTION_STRING) {
+        if (type != LUA_TSTRING && type != LUA_TNUMBER) {
+            throw std::logic_error(error + "a string");
+        }
+    } else if (option->type == OPTION_BOOL) {
+        if (type != LUA_TBOOLEAN) {
+            throw std::logic_error(error + "a boolean");
+        }
+    } else {
+        if (type != LUA_TNUMBER) {
+            throw std::logic_error(error + "a number");
+        }
+        lua_Number value = lua_tonumber(L, -1);
+        bool is_int = (option->type == OPTION_INT);
+        if (is_int && value != std::floor(value)) {
+            throw std::logic_error(error + "an integer");
+        }
+        if (value < option->min) {
+            std::ostringstream min;
+            min << option->min;
+            throw std::logic_error(error + ">= " + min.str());
+        }
+    }
+}
+
+/* Returns a copy of the table of options (argument 1). */
+static void luawt_copyServerOptions(lua_State* L) {
     luaL_checktype(L, 1, LUA_TTABLE);
-    // get code
-    lua_getfield(L, 1, "code");
-    size_t code_len;
-    const char* code = luaL_checklstring(L, -1, &code_len);
-    // get IP
-    lua_getfield(L, 1, "ip");
-    const char* ip = luaL_checkstring(L, -1);
-    // get port
-    lua_getfield(L, 1, "port");
-    const char* port = luaL_checkstring(L, -1);
-    // get config
-    const char* config = 0;
-    lua_getfield(L, 1, "wt_config");
+    lua_newtable(L);
+    lua_pushnil(L);
+    while (lua_next(L, 1) != 0) {
+        if (lua_type(L, -2) != LUA_TSTRING) {
+            throw std::logic_error("LuaWt: names of options of WServer "
+                                   "must be strings");
+        }
+        const char* name = lua_tostring(L, -2);
+        const ServerOption* option = luawt_findServerOption(name);
+        if (!option) {
+            throw std::logic_error(std::string("LuaWt: unknown option "
+                                               "of WServer: ") + name);
+        }
+        luawt_checkServerOption(L, option);
+        lua_pushvalue(L, -2); // name
+        lua_insert(L, -2);
+        lua_rawset(L, -4);
+    }
+}
+
+static std::string luawt_escapeXml(const std::string& text) {
+    std::string result;
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '&') {
+            result += "&amp;";
+        } else if (c == '<') {
+            result += "&lt;";
+        } else if (c == '>') {
+            result += "&gt;";
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+/* Generates wt_config.xml for options with XML elements.
+   Returns empty string if no such options are set.
+   Table of options must be at the top of the stack.
+*/
+static std::string luawt_makeWtConfig(lua_State* L) {
+    std::ostringstream groups[2];
+    const char* group_names[2] = {0, "session-management"};
+    bool has_elements = false;
+    for (const ServerOption* o = luawt_server_options; o->name; ++o) {
+        if (!o->element) {
+            continue;
+        }
+        lua_getfield(L, -1, o->name);
+        if (!lua_isnil(L, -1)) {
+            has_elements = true;
+            std::ostringstream& out = groups[o->group ? 1 : 0];
+            out << "<" << o->element << ">";
+            if (o->type == OPTION_BOOL) {
+                out << (lua_toboolean(L, -1) ? "true" : "false");
+            } else {
+                out << luawt_escapeXml(lua_tostring(L, -1));
+            }
+            out << "</" << o->element << ">\n";
+        }
+        lua_pop(L, 1); // value
+    }
+    if (!has_elements) {
+        return std::string();
+    }
+    std::ostringstream xml;
+    xml << "<server>\n<application-settings location=\"*\">\n";
+    xml << groups[0].str();
+    if (!groups[1].str().empty()) {
+        xml << "<" << group_names[1] << ">\n";
+        xml << groups[1].str();
+        xml << "</" << group_names[1] << ">\n";
+    }
+    xml << "</application-settings>\n</server>\n";
+    return xml.str();
+}
+
+/* Wt reads its configuration only from a file, so the generated
+   configuration is written to a private temporary file which lives
+   as long as the server.
+*/
+static std::string luawt_writeTempFile(const std::string& content) {
+    const char* tmpdir = getenv("TMPDIR");
+    std::string path = std::string(tmpdir ? tmpdir : "/tmp");
+    path += "/luawt-XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    int fd = mkstemp(&name[0]);
+    if (fd == -1) {
+        throw std::runtime_error("LuaWt: unable to create "
+                                 "configuration file");
+    }
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t n = ::write(
+            fd,
+            content.data() + written,
+            content.size() - written
+        );
+        if (n <= 0) {
+            ::close(fd);
+            ::unlink(&name[0]);
+            throw std::runtime_error("LuaWt: unable to write "
+                                     "configuration file");
+        }
+        written += n;
+    }
+    ::close(fd);
+    return std::string(&name[0]);
+}
+
+static lua_Number luawt_optNumberField(
+    lua_State* L,
+    int index,
+    const char* name,
+    lua_Number default_value
+) {
+    lua_getfield(L, index, name);
+    lua_Number value = lua_isnil(L, -1) ?
+                       default_value : lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    return value;
+}
+
+/* Reads options of admission control from the table of options.
+   Rate is in sessions per second.
+*/
+static luawt_AdmissionOptions luawt_admissionOptions(
+    lua_State* L,
+    int options
+) {
+    luawt_AdmissionOptions a;
+    a.max_bootstraps = luawt_optNumberField(L, options,
+                                            "max_bootstraps", 0);
+    a.max_sessions = luawt_optNumberField(L, options, "max_sessions", 0);
+    a.ip_rate = luawt_optNumberField(L, options,
+                                     "sessions_per_ip_rate", 0);
+    a.ip_burst = luawt_optNumberField(L, options,
+                                      "sessions_per_ip_burst", 10);
+    a.busy_refresh = luawt_optNumberField(L, options, "busy_refresh", 5);
+    return a;
+}
+
+/* Reads options of session states. session_memory_limit is
+   in kilobytes, 0 tracks memory without a limit. It can't be
+   combined with shared_states: sessions of a shared state use
+   one allocator, so their memory is not counted per session.
+   gc_mode is "incremental" (default) or "generational" (Lua 5.4).
+*/
+static luawt_AppOptions luawt_appOptions(lua_State* L, int options) {
+    luawt_AppOptions a;
+    lua_getfield(L, options, "session_memory_limit");
     if (!lua_isnil(L, -1)) {
-        config = luaL_checkstring(L, -1);
+        a.track_memory = true;
+        a.memory_limit = 1024 * static_cast<size_t>(lua_tonumber(L, -1));
+    }
+    lua_pop(L, 1);
+    if (a.memory_limit) {
+        // each session opens the libraries before running any code
+        size_t baseline = luawt_baselineMemory(luawt_getShared(L));
+        if (a.memory_limit <= baseline) {
+            std::ostringstream message;
+            message << "LuaWt: option 'session_memory_limit' of WServer "
+                    << "must exceed " << baseline / 1024 << " KiB used "
+                    << "by a new session state";
+            throw std::logic_error(message.str());
+        }
+    }
+    lua_getfield(L, options, "gc_mode");
+    if (!lua_isnil(L, -1)) {
+        std::string mode = lua_tostring(L, -1);
+        if (mode == "generational") {
+#if LUA_VERSION_NUM >= 504
+            a.gc_generational = true;
+#else
+            throw std::logic_error("LuaWt: generational GC needs "
+                                   "Lua 5.4");
+#endif
+        } else if (mode != "incremental") {
+            throw std::logic_error("LuaWt: option 'gc_mode' of WServer "
+                                   "must be incremental or generational");
+        }
+    }
+    lua_pop(L, 1);
+    a.gc_pause = luawt_optNumberField(L, options, "gc_pause", 0);
+    a.gc_stepmul = luawt_optNumberField(L, options, "gc_stepmul", 0);
+    lua_getfield(L, options, "gc_defer_events");
+    a.gc_defer_events = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+    a.gc_idle_step = luawt_optNumberField(L, options, "gc_idle_step", 0);
+    a.hibernate_after_ms = 1000 * luawt_optNumberField(L, options,
+                           "hibernate_after", 0);
+    a.handler_instructions = luawt_optNumberField(L, options,
+                             "handler_instructions", 0);
+    a.handler_timeout_ms = 1000 * luawt_optNumberField(L, options,
+                           "handler_timeout", 0);
+    return a;
+}
+
+luawt_Server* luawt_checkServer(lua_State* L, int index) {
+    return reinterpret_cast<luawt_Server*>(
+            luaL_checkudata(L, index, "luawt_WServer")
+        );
+}
+
+/** Creates the Wt application server
+    Argument 1 is table of options (see luawt_server_options).
+    Options are validated before the server is created.
+*/
+int luawt_WServer_make(lua_State* L) {
+    luawt_copyServerOptions(L);
+    int options = lua_gettop(L);
+    // get code of the default entry point (optional)
+    lua_getfield(L, options, "code");
+    bool has_code = !lua_isnil(L, -1);
+    std::string code_str;
+    if (has_code) {
+        size_t code_len;
+        const char* code = lua_tolstring(L, -1, &code_len);
+        code_str.assign(code, code_len);
+    }
+    lua_pop(L, 1); // code
+    const char* required[] = {"ip", "port", NULL};
+    for (int i = 0; required[i]; i++) {
+        lua_getfield(L, options, required[i]);
+        if (lua_isnil(L, -1)) {
+            throw std::logic_error(std::string("LuaWt: option '") +
+                                   required[i] + "' of WServer "
+                                   "is required");
+        }
+        lua_pop(L, 1);
+    }
+    lua_pushvalue(L, options);
+    std::string wt_config = luawt_makeWtConfig(L);
+    lua_pop(L, 1); // options
+    lua_getfield(L, options, "wt_config");
+    if (!wt_config.empty() && !lua_isnil(L, -1)) {
+        throw std::logic_error("LuaWt: option 'wt_config' of WServer "
+                               "can't be combined with options which "
+                               "are written to wt_config.xml");
+    }
+    lua_pop(L, 1); // wt_config
+    lua_getfield(L, options, "docroot");
+    if (lua_isnil(L, -1)) {
+        lua_pushstring(L, "/usr/include/Wt");
+        lua_setfield(L, options, "docroot");
     }
-    // get document root for static files
-    const char* docroot = 0;
-    lua_getfield(L, 1, "docroot");
+    lua_pop(L, 1); // docroot
+    lua_getfield(L, options, "time_bindings");
     if (!lua_isnil(L, -1)) {
-        docroot = luaL_checkstring(L, -1);
+        luawt_time_bindings = lua_toboolean(L, -1);
+    }
+    lua_pop(L, 1); // time_bindings
+    // options which may be rejected are parsed before the server
+    // and the temporary config file are made, so nothing leaks
+    luawt_AdmissionOptions admission_options =
+        luawt_admissionOptions(L, options);
+    luawt_AppOptions app_options = luawt_appOptions(L, options);
+    lua_getfield(L, options, "shared_states");
+    int shared_states = lua_tointeger(L, -1);
+    lua_pop(L, 1); // shared_states
+    if (shared_states && app_options.track_memory) {
+        throw std::logic_error("LuaWt: options 'session_memory_limit' "
+                               "and 'shared_states' of WServer can't "
+                               "be used together");
     }
     // make argc, argv
+    typedef std::vector<std::string> Arguments;
+    Arguments arguments;
+    arguments.push_back("luawt");
+    for (const ServerOption* o = luawt_server_options; o->name; ++o) {
+        if (!o->argument) {
+            continue;
+        }
+        lua_getfield(L, options, o->name);
+        if (!lua_isnil(L, -1)) {
+            arguments.push_back(o->argument);
+            arguments.push_back(lua_tostring(L, -1));
+        }
+        lua_pop(L, 1); // value
+    }
+    std::string config_file;
+    if (!wt_config.empty()) {
+        config_file = luawt_writeTempFile(wt_config);
+        arguments.push_back("--config");
+        arguments.push_back(config_file);
+    }
     typedef std::vector<const char*> Options;
     Options opt;
-    opt.push_back("luawt");
-    opt.push_back("--http-address");
-    opt.push_back(ip);
-    opt.push_back("--http-port");
-    opt.push_back(port);
-    if (config) {
-        opt.push_back("--config");
-        opt.push_back(config);
-    }
-    if (docroot) {
-        opt.push_back("--docroot");
-        opt.push_back(docroot);
-    } else {
-        opt.push_back("--docroot=/usr/include/Wt");
+    for (size_t i = 0; i < arguments.size(); i++) {
+        opt.push_back(arguments[i].c_str());
     }
     opt.push_back(0);
-    WServer* server = reinterpret_cast<WServer*>(
-            lua_newuserdata(L, sizeof(WServer))
+    luawt_Server* s = reinterpret_cast<luawt_Server*>(
+            lua_newuserdata(L, sizeof(luawt_Server))
         );
+    new (s) luawt_Server();
+    s->config_file = config_file;
+    s->options_ref = LUA_NOREF;
+    // set metatable now to destroy the server in __gc on errors
+    luaL_getmetatable(L, "luawt_WServer");
+    lua_setmetatable(L, -2);
+    s->admission.reset(new luawt_Admission(admission_options));
+    s->app_options = app_options;
+    if (shared_states) {
+        s->states.reset(new luawt_StatePool(
+            luawt_getShared(L),
+            shared_states,
+            s->app_options
+        ));
+    }
+    lua_pushvalue(L, options);
+    s->options_ref = luaL_ref(L, LUA_REGISTRYINDEX);
     int argc = opt.size() - 1;
     char** argv = const_cast<char**>(&opt[0]);
-    new (server) WServer();
-    server->setServerConfiguration(argc, argv);
-    server->addEntryPoint(
-        Wt::Application,
+    s->server.setServerConfiguration(argc, argv);
+    if (has_code) {
+        AppCodePtr app_code(new luawt_AppCode(
+            luawt_compileApp(L, code_str)
+        ));
+        s->apps[""] = app_code;
+        s->server.addEntryPoint(
+            Wt::Application,
+            luawt_AppCreator(
+                luawt_getShared(L),
+                app_code,
+                s->admission,
+                s->app_options,
+                s->states
+            )
+        );
+    }
+    return 1;
+}
+
+/* Pushes field of the options of entry point (argument 2).
+   Returns 0 if it is nil, throws if it is not a string.
+*/
+static const char* luawt_entryPointField(
+    lua_State* L,
+    const char* name,
+    size_t* len = 0
+) {
+    lua_getfield(L, 2, name);
+    if (lua_isnil(L, -1)) {
+        return 0;
+    }
+    if (lua_type(L, -1) != LUA_TSTRING) {
+        throw std::logic_error(std::string("LuaWt: option '") + name +
+                               "' of entry point must be a string");
+    }
+    return lua_tolstring(L, -1, len);
+}
+
+/** Adds an application to the server
+    Argument 1 is the server, argument 2 is table of options:
+     - code (required) -- code of the application,
+     - path (required) -- deployment path, e.g. "/admin",
+     - type -- "application" (default) or "widgetset",
+     - favicon -- URL of favicon.
+    All entry points share threads and Shared of the server.
+    Must be called before start().
+*/
+int luawt_WServer_addEntryPoint(lua_State* L) {
+    luawt_Server* s = luawt_checkServer(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    if (s->started) {
+        throw std::logic_error("LuaWt: entry points must be added "
+                               "before the server is started");
+    }
+    const char* fields[] = {"code", "path", "type", "favicon", NULL};
+    lua_pushnil(L);
+    while (lua_next(L, 2) != 0) {
+        bool known = false;
+        if (lua_type(L, -2) == LUA_TSTRING) {
+            const char* name = lua_tostring(L, -2);
+            for (int i = 0; fields[i]; i++) {
+                known = known || (strcmp(name, fields[i]) == 0);
+            }
+        }
+        if (!known || lua_type(L, -1) != LUA_TSTRING) {
+            throw std::logic_error("LuaWt: options of entry point are "
+                                   "strings code, path, type, favicon");
+        }
+        lua_pop(L, 1); // value
+    }
+    // fields are read again: __index of the table may return
+    // values which the loop above didn't see
+    size_t code_len;
+    const char* code = luawt_entryPointField(L, "code", &code_len);
+    const char* path = luawt_entryPointField(L, "path");
+    if (!code || !path) {
+        throw std::logic_error("LuaWt: code and path of entry point "
+                               "are required");
+    }
+    const char* type_str = luawt_entryPointField(L, "type");
+    EntryPointType type = Wt::Application;
+    if (type_str) {
+        if (strcmp(type_str, "widgetset") == 0) {
+            type = Wt::WidgetSet;
+        } else if (strcmp(type_str, "application") != 0) {
+            throw std::logic_error("LuaWt: type of entry point must be "
+                                   "'application' or 'widgetset'");
+        }
+    }
+    const char* favicon_str = luawt_entryPointField(L, "favicon");
+    std::string favicon = favicon_str ? favicon_str : "";
+    AppCodePtr app_code(new luawt_AppCode(
+        luawt_compileApp(L, std::string(code, code_len))
+    ));
+    s->apps[path] = app_code;
+    s->server.addEntryPoint(
+        type,
         luawt_AppCreator(
             luawt_getShared(L),
-            std::string(code, code_len)
-        )
+            app_code,
+            s->admission,
+            s->app_options,
+            s->states
+        ),
+        path,
+        favicon
     );
-    luaL_getmetatable(L, "luawt_WServer");
-    lua_setmetatable(L, -2);
+    return 0;
+}
+
+/** Replaces code of an application without restarting the server
+    Argument 1 is the server, argument 2 is table of options:
+     - code (required) -- new code of the application,
+     - path -- deployment path of the entry point
+       (default: the entry point created from option 'code').
+    New sessions run the new code, existing sessions keep running.
+    The code is compiled before the swap: on errors the old code
+    stays in use. Returns the version of the code (1 is initial).
+*/
+int luawt_WServer_reload(lua_State* L) {
+    luawt_Server* s = luawt_checkServer(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_getfield(L, 2, "code");
+    if (lua_type(L, -1) != LUA_TSTRING) {
+        throw std::logic_error("LuaWt: code passed to reload "
+                               "must be a string");
+    }
+    size_t code_len;
+    const char* code = lua_tolstring(L, -1, &code_len);
+    lua_getfield(L, 2, "path");
+    if (!lua_isnil(L, -1) && lua_type(L, -1) != LUA_TSTRING) {
+        throw std::logic_error("LuaWt: path passed to reload "
+                               "must be a string");
+    }
+    std::string path;
+    if (!lua_isnil(L, -1)) {
+        path = lua_tostring(L, -1);
+    }
+    std::map<std::string, AppCodePtr>::iterator it = s->apps.find(path);
+    if (it == s->apps.end()) {
+        throw std::logic_error("LuaWt: no entry point with path '" +
+                               path + "' to reload");
+    }
+    std::string bytecode = luawt_compileApp(
+                               L,
+                               std::string(code, code_len)
+                           );
+    int version = it->second->set(bytecode);
+    lua_pushinteger(L, version);
+    return 1;
+}
+
+/** Returns a copy of options of the server
+    Defaults set by luawt (e.g., docroot) are included.
+*/
+int luawt_WServer_config(lua_State* L) {
+    luawt_Server* s = luawt_checkServer(L, 1);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, s->options_ref);
+    int options = lua_gettop(L);
+    lua_newtable(L);
+    lua_pushnil(L);
+    while (lua_next(L, options) != 0) {
+        lua_pushvalue(L, -2); // name
+        lua_insert(L, -2);
+        lua_rawset(L, -4);
+    }
+    return 1;
+}
+
+/** Serves HTTP requests to the path by a Lua function
+    Argument 1 is the server, argument 2 is the path, argument 3
+    is the handler: either a function (its upvalues are not kept)
+    or a string with code returning the function.
+    The handler is called as handler(request, response) in a Lua
+    state of the worker thread, without a session. It writes
+    the response with response:write(...) and friends and returns
+    nil, or a cursor to be called again for the next chunk
+    (request.continuation is set to the cursor then).
+    Must be called before start().
+*/
+int luawt_WServer_addResource(lua_State* L) {
+    luawt_Server* s = luawt_checkServer(L, 1);
+    const char* path = luaL_checkstring(L, 2);
+    if (s->started) {
+        throw std::logic_error("LuaWt: resources must be added "
+                               "before the server is started");
+    }
+    std::string code;
+    bool is_chunk;
+    if (lua_type(L, 3) == LUA_TFUNCTION) {
+        lua_pushvalue(L, 3);
+        code = luawt_dumpFunction(L);
+        lua_pop(L, 1); // function
+        is_chunk = false;
+    } else {
+        size_t code_len;
+        const char* code_raw = luaL_checklstring(L, 3, &code_len);
+        code.assign(code_raw, code_len);
+        // check syntax now rather than in a worker thread
+        int status = luaL_loadbuffer(
+                         L,
+                         code.c_str(),
+                         code.size(),
+                         "resource"
+                     );
+        checkPcallStatus(L, status);
+        lua_pop(L, 1); // chunk
+        is_chunk = true;
+    }
+    boost::shared_ptr<WResource> resource(luawt_makeLuaResource(
+            luawt_getShared(L),
+            code,
+            is_chunk
+        ));
+    s->resources.push_back(resource);
+    s->server.addResource(resource.get(), path);
+    return 0;
+}
+
+/** Serves files of a directory from memory
+    Argument 2 is the path of the resource (e.g., "/css").
+    Argument 3 is the directory or table of options:
+    dir, max_age (seconds, default 3600), max_file_size (kilobytes,
+    default 1024), preload (default false), gzip (default true).
+    Larger files are read on each request and sent uncompressed.
+    Requested path is mapped to the file dir + path info.
+*/
+int luawt_WServer_addStaticResource(lua_State* L) {
+    luawt_Server* s = luawt_checkServer(L, 1);
+    const char* path = luaL_checkstring(L, 2);
+    if (s->started) {
+        throw std::logic_error("LuaWt: resources must be added "
+                               "before the server is started");
+    }
+    luawt_StaticOptions options;
+    options.max_age = 3600;
+    options.max_file_size = 1024 * 1024;
+    options.preload = false;
+    options.gzip = true;
+    if (lua_type(L, 3) == LUA_TTABLE) {
+        lua_getfield(L, 3, "dir");
+        if (lua_type(L, -1) != LUA_TSTRING) {
+            throw std::logic_error("LuaWt: option 'dir' of static "
+                                   "resource must be a string");
+        }
+        options.dir = lua_tostring(L, -1);
+        lua_pop(L, 1);
+        lua_getfield(L, 3, "max_age");
+        if (!lua_isnil(L, -1)) {
+            options.max_age = luaL_checkinteger(L, -1);
+        }
+        lua_pop(L, 1);
+        lua_getfield(L, 3, "max_file_size");
+        if (!lua_isnil(L, -1)) {
+            options.max_file_size = luaL_checkinteger(L, -1) * 1024;
+        }
+        lua_pop(L, 1);
+        lua_getfield(L, 3, "preload");
+        if (!lua_isnil(L, -1)) {
+            options.preload = lua_toboolean(L, -1);
+        }
+        lua_pop(L, 1);
+        lua_getfield(L, 3, "gzip");
+        if (!lua_isnil(L, -1)) {
+            options.gzip = lua_toboolean(L, -1);
+        }
+        lua_pop(L, 1);
+    } else {
+        options.dir = luaL_checkstring(L, 3);
+    }
+    boost::shared_ptr<WResource> resource(
+        luawt_makeStaticResource(options)
+    );
+    s->resources.push_back(resource);
+    s->server.addResource(resource.get(), path);
+    return 0;
+}
+
+/** Returns table of metrics of the process
+    Includes counters of sessions and errors and histograms of
+    session creation, events, slots, binding calls (if option
+    time_bindings is set), waiting for luawt.Shared and memory of
+    Lua states. Times are in microseconds, memory in kilobytes.
+*/
+int luawt_WServer_stats(lua_State* L) {
+    luawt_checkServer(L, 1);
+    luawt_pushStats(L);
     return 1;
 }
 
+/** Serves the metrics in Prometheus text format
+    Argument 2 is the path (e.g., "/metrics").
+    Must be called before start().
+*/
+int luawt_WServer_addMetricsResource(lua_State* L) {
+    luawt_Server* s = luawt_checkServer(L, 1);
+    const char* path = luaL_checkstring(L, 2);
+    if (s->started) {
+        throw std::logic_error("LuaWt: resources must be added "
+                               "before the server is started");
+    }
+    boost::shared_ptr<WResource> resource(luawt_makeMetricsResource());
+    s->resources.push_back(resource);
+    s->server.addResource(resource.get(), path);
+    return 0;
+}
+
 int luawt_WServer_start(lua_State* L) {
-    WServer* server = reinterpret_cast<WServer*>(
-            luaL_checkudata(L, 1, "luawt_WServer")
-        );
-    bool ok = server->start();
+    luawt_Server* s = luawt_checkServer(L, 1);
+    bool ok = s->server.start();
+    if (ok) {
+        s->started = true;
+    }
     lua_pushboolean(L, ok);
     return 1;
 }
 
 int luawt_WServer_stop(lua_State* L) {
-    WServer* s = reinterpret_cast<WServer*>(
-            luaL_checkudata(L, 1, "luawt_WServer")
-        );
+    WServer* s = &luawt_checkServer(L, 1)->server;
     bool force = lua_toboolean(L, 2);
     if (force) {
         s->ioService().boost::asio::io_service::stop();
     }
     s->stop();
+    luawt_quitMain();
+    luawt_stopJobs();
     return 0;
 }
 
+/** Runs tasks of luawt.main until shutdown of the server
+    Replaces waitForShutdown(): tasks posted by sessions are run
+    in this Lua state by handlers registered with luawt.main.handle.
+    Returns the number of the signal which stopped the loop
+    or nil if the loop was stopped by stop().
+*/
+int luawt_WServer_run(lua_State* L) {
+    luawt_Server* s = luawt_checkServer(L, 1);
+    if (!s->started) {
+        throw std::logic_error("LuaWt: server must be started "
+                               "before run()");
+    }
+    int sig = luawt_runMain(L, s->server);
+    if (sig) {
+        lua_pushinteger(L, sig);
+    } else {
+        lua_pushnil(L);
+    }
+    return 1;
+}
+
 int luawt_WServer_waitForShutdown(lua_State* L) {
-    WServer* s = reinterpret_cast<WServer*>(
-            luaL_checkudata(L, 1, "luawt_WServer")
-        );
+    WServer* s = &luawt_checkServer(L, 1)->server;
     s->waitForShutdown();
     return 0;
 }
 
 int luawt_WServer_gc(lua_State* L) {
-    WServer* s = reinterpret_cast<WServer*>(
-            luaL_checkudata(L, 1, "luawt_WServer")
-        );
-    s->WServer::~WServer();
+    luawt_Server* s = luawt_checkServer(L, 1);
+    std::string config_file = s->config_file;
+    luaL_unref(L, LUA_REGISTRYINDEX, s->options_ref);
+    s->~luawt_Server();
+    if (!config_file.empty()) {
+        ::unlink(config_file.c_str());
+    }
     return 0;
 }
 
@@ -150,7 +928,15 @@ static const luaL_Reg luawt_WServer_mt[] = {
 };
 
 static const luaL_Reg luawt_WServer_methods[] = {
+    METHOD(WServer, addEntryPoint),
+    METHOD(WServer, addMetricsResource),
+    METHOD(WServer, addResource),
+    METHOD(WServer, addStaticResource),
+    METHOD(WServer, config),
+    METHOD(WServer, reload),
+    METHOD(WServer, run),
     METHOD(WServer, start),
+    METHOD(WServer, stats),
     METHOD(WServer, stop),
     METHOD(WServer, waitForShutdown),
     {NULL, NULL},
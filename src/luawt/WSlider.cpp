@@ -23,7 +23,7 @@ int luawt_WSlider_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WSlider");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -46,7 +46,7 @@ int luawt_WSlider_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WSlider");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
@@ -156,7 +156,7 @@ int luawt_WSlider_valueText(lua_State* L) {
     WSlider* self = luawt_checkFromLua<WSlider>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->valueText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WSlider.valueText");
@@ -248,8 +248,7 @@ int luawt_WSlider_setValueText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WSlider_setValueText_args);
     WSlider* self = luawt_checkFromLua<WSlider>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString value = Wt::WString(raw2);
+        Wt::WString value = luawt_toWString(L, 2);
         self->setValueText(value);
         return 0;
     } else {
@@ -24,7 +24,7 @@ int luawt_WSplitButton_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WSplitButton");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -34,20 +34,18 @@ int luawt_WSplitButton_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString label = Wt::WString(raw1);
+        Wt::WString label = luawt_toWString(L, 1);
         WSplitButton* l_result = new WSplitButton(label);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WSplitButton");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString label = Wt::WString(raw1);
+        Wt::WString label = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WSplitButton* l_result = new WSplitButton(label, parent);
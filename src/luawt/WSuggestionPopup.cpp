@@ -30,15 +30,12 @@ int luawt_WSuggestionPopup_addSuggestion(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WSuggestionPopup_addSuggestion_args);
     WSuggestionPopup* self = luawt_checkFromLua<WSuggestionPopup>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString suggestionText = Wt::WString(raw2);
+        Wt::WString suggestionText = luawt_toWString(L, 2);
         self->addSuggestion(suggestionText);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString suggestionText = Wt::WString(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString suggestionValue = Wt::WString(raw3);
+        Wt::WString suggestionText = luawt_toWString(L, 2);
+        Wt::WString suggestionValue = luawt_toWString(L, 3);
         self->addSuggestion(suggestionText, suggestionValue);
         return 0;
     } else {
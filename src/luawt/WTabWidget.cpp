@@ -23,7 +23,7 @@ int luawt_WTabWidget_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTabWidget");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -46,7 +46,7 @@ int luawt_WTabWidget_tabToolTip(lua_State* L) {
     if (index == 0) {
         int index = lua_tointeger(L, 2);
         Wt::WString const& l_result = self->tabToolTip(index);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTabWidget.tabToolTip");
@@ -77,7 +77,7 @@ int luawt_WTabWidget_internalBasePath(lua_State* L) {
     WTabWidget* self = luawt_checkFromLua<WTabWidget>(L, 1);
     if (index == 0) {
         std::string const& l_result = self->internalBasePath();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTabWidget.internalBasePath");
@@ -141,8 +141,7 @@ int luawt_WTabWidget_setInternalPathEnabled(lua_State* L) {
         self->setInternalPathEnabled();
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string basePath = std::string(raw2);
+        std::string basePath = luawt_toStdString(L, 2);
         self->setInternalPathEnabled(basePath);
         return 0;
     } else {
@@ -254,7 +253,7 @@ int luawt_WTabWidget_tabText(lua_State* L) {
     if (index == 0) {
         int index = lua_tointeger(L, 2);
         Wt::WString const& l_result = self->tabText(index);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTabWidget.tabText");
@@ -271,16 +270,14 @@ int luawt_WTabWidget_addTab(lua_State* L) {
     if (index == 0) {
         Wt::WWidget* child =
             luawt_checkFromLua<Wt::WWidget>(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString label = Wt::WString(raw3);
+        Wt::WString label = luawt_toWString(L, 3);
         Wt::WMenuItem* l_result = self->addTab(child, label);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
         Wt::WWidget* child =
             luawt_checkFromLua<Wt::WWidget>(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString label = Wt::WString(raw3);
+        Wt::WString label = luawt_toWString(L, 3);
         Wt::WTabWidget::LoadPolicy arg2 = static_cast<Wt::WTabWidget::LoadPolicy>(luawt_getEnum(
                     L,
                     luawt_enum_WTabWidget_LoadPolicy_str,
@@ -350,8 +347,7 @@ int luawt_WTabWidget_setTabText(lua_State* L) {
     WTabWidget* self = luawt_checkFromLua<WTabWidget>(L, 1);
     if (index == 0) {
         int index = lua_tointeger(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString label = Wt::WString(raw3);
+        Wt::WString label = luawt_toWString(L, 3);
         self->setTabText(index, label);
         return 0;
     } else {
@@ -367,8 +363,7 @@ int luawt_WTabWidget_setTabToolTip(lua_State* L) {
     WTabWidget* self = luawt_checkFromLua<WTabWidget>(L, 1);
     if (index == 0) {
         int index = lua_tointeger(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString tip = Wt::WString(raw3);
+        Wt::WString tip = luawt_toWString(L, 3);
         self->setTabToolTip(index, tip);
         return 0;
     } else {
@@ -383,8 +378,7 @@ int luawt_WTabWidget_setInternalBasePath(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTabWidget_setInternalBasePath_args);
     WTabWidget* self = luawt_checkFromLua<WTabWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string path = std::string(raw2);
+        std::string path = luawt_toStdString(L, 2);
         self->setInternalBasePath(path);
         return 0;
     } else {
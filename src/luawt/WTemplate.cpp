@@ -23,7 +23,7 @@ int luawt_WTemplate_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTemplate");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -33,20 +33,18 @@ int luawt_WTemplate_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WTemplate* l_result = new WTemplate(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTemplate");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WTemplate* l_result = new WTemplate(text, parent);
@@ -64,8 +62,7 @@ int luawt_WTemplate_conditionValue(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_conditionValue_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         bool l_result = self->conditionValue(name);
         lua_pushboolean(L, l_result);
         return 1;
@@ -81,8 +78,7 @@ int luawt_WTemplate_setCondition(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_setCondition_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         bool value = lua_toboolean(L, 3);
         self->setCondition(name, value);
         return 0;
@@ -99,13 +95,11 @@ int luawt_WTemplate_setTemplateText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_setTemplateText_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setTemplateText(text);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -127,8 +121,7 @@ int luawt_WTemplate_bindEmpty(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_bindEmpty_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string varName = std::string(raw2);
+        std::string varName = luawt_toStdString(L, 2);
         self->bindEmpty(varName);
         return 0;
     } else {
@@ -159,7 +152,7 @@ int luawt_WTemplate_templateText(lua_State* L) {
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->templateText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTemplate.templateText");
@@ -188,17 +181,13 @@ int luawt_WTemplate_bindString(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_bindString_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string varName = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString value = Wt::WString(raw3);
+        std::string varName = luawt_toStdString(L, 2);
+        Wt::WString value = luawt_toWString(L, 3);
         self->bindString(varName, value);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string varName = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString value = Wt::WString(raw3);
+        std::string varName = luawt_toStdString(L, 2);
+        Wt::WString value = luawt_toWString(L, 3);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -234,8 +223,7 @@ int luawt_WTemplate_bindWidget(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_bindWidget_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string varName = std::string(raw2);
+        std::string varName = luawt_toStdString(L, 2);
         Wt::WWidget* widget =
             luawt_checkFromLua<Wt::WWidget>(L, 3);
         self->bindWidget(varName, widget);
@@ -252,8 +240,7 @@ int luawt_WTemplate_takeWidget(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_takeWidget_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string varName = std::string(raw2);
+        std::string varName = luawt_toStdString(L, 2);
         Wt::WWidget* l_result = self->takeWidget(varName);
         luawt_toLua(L, l_result);
         return 1;
@@ -269,8 +256,7 @@ int luawt_WTemplate_resolveWidget(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_resolveWidget_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string varName = std::string(raw2);
+        std::string varName = luawt_toStdString(L, 2);
         Wt::WWidget* l_result = self->resolveWidget(varName);
         luawt_toLua(L, l_result);
         return 1;
@@ -301,8 +287,7 @@ int luawt_WTemplate_bindInt(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTemplate_bindInt_args);
     WTemplate* self = luawt_checkFromLua<WTemplate>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string varName = std::string(raw2);
+        std::string varName = luawt_toStdString(L, 2);
         int value = lua_tointeger(L, 3);
         self->bindInt(varName, value);
         return 0;
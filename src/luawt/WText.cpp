@@ -7,6 +7,7 @@
 
 #include "enums.hpp"
 #include "globals.hpp"
+#include "marshal.hpp"
 
 static const char* WText_make_args0[] = {NULL};
 static const char* WText_make_args1[] = {luawt_typeToStr<Wt::WContainerWidget>(), NULL};
@@ -25,7 +26,7 @@ int luawt_WText_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WText");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -35,28 +36,25 @@ int luawt_WText_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WText* l_result = new WText(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WText");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WText* l_result = new WText(text, parent);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 4) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -70,12 +68,11 @@ int luawt_WText_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WText");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 5) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -93,67 +90,6 @@ int luawt_WText_make(lua_State* L) {
     }
 }
 
-static const char* WText_hasInternalPathEncoding_args0[] = {luawt_typeToStr<WText>(), NULL};
-static const char* const* const luawt_WText_hasInternalPathEncoding_args[] = {WText_hasInternalPathEncoding_args0, NULL};
-
-int luawt_WText_hasInternalPathEncoding(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WText_hasInternalPathEncoding_args);
-    WText* self = luawt_checkFromLua<WText>(L, 1);
-    if (index == 0) {
-        bool l_result = self->hasInternalPathEncoding();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WText.hasInternalPathEncoding");
-    }
-}
-
-static const char* WText_text_args0[] = {luawt_typeToStr<WText>(), NULL};
-static const char* const* const luawt_WText_text_args[] = {WText_text_args0, NULL};
-
-int luawt_WText_text(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WText_text_args);
-    WText* self = luawt_checkFromLua<WText>(L, 1);
-    if (index == 0) {
-        Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WText.text");
-    }
-}
-
-static const char* WText_setText_args0[] = {luawt_typeToStr<WText>(), "char const *", NULL};
-static const char* const* const luawt_WText_setText_args[] = {WText_setText_args0, NULL};
-
-int luawt_WText_setText(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WText_setText_args);
-    WText* self = luawt_checkFromLua<WText>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
-        bool l_result = self->setText(text);
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WText.setText");
-    }
-}
-
-static const char* WText_refresh_args0[] = {luawt_typeToStr<WText>(), NULL};
-static const char* const* const luawt_WText_refresh_args[] = {WText_refresh_args0, NULL};
-
-int luawt_WText_refresh(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WText_refresh_args);
-    WText* self = luawt_checkFromLua<WText>(L, 1);
-    if (index == 0) {
-        self->refresh();
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WText.refresh");
-    }
-}
-
 static const char* WText_setPadding_args0[] = {luawt_typeToStr<WText>(), "double", NULL};
 static const char* WText_setPadding_args1[] = {luawt_typeToStr<WText>(), "double", "enum", NULL};
 static const char* const* const luawt_WText_setPadding_args[] = {WText_setPadding_args0, WText_setPadding_args1, NULL};
@@ -205,36 +141,6 @@ int luawt_WText_padding(lua_State* L) {
     }
 }
 
-static const char* WText_wordWrap_args0[] = {luawt_typeToStr<WText>(), NULL};
-static const char* const* const luawt_WText_wordWrap_args[] = {WText_wordWrap_args0, NULL};
-
-int luawt_WText_wordWrap(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WText_wordWrap_args);
-    WText* self = luawt_checkFromLua<WText>(L, 1);
-    if (index == 0) {
-        bool l_result = self->wordWrap();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WText.wordWrap");
-    }
-}
-
-static const char* WText_setWordWrap_args0[] = {luawt_typeToStr<WText>(), "bool", NULL};
-static const char* const* const luawt_WText_setWordWrap_args[] = {WText_setWordWrap_args0, NULL};
-
-int luawt_WText_setWordWrap(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WText_setWordWrap_args);
-    WText* self = luawt_checkFromLua<WText>(L, 1);
-    if (index == 0) {
-        bool wordWrap = lua_toboolean(L, 2);
-        self->setWordWrap(wordWrap);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WText.setWordWrap");
-    }
-}
-
 static const char* WText_textFormat_args0[] = {luawt_typeToStr<WText>(), NULL};
 static const char* const* const luawt_WText_textFormat_args[] = {WText_textFormat_args0, NULL};
 
@@ -272,20 +178,13 @@ int luawt_WText_setTextFormat(lua_State* L) {
     }
 }
 
-static const char* WText_setInternalPathEncoding_args0[] = {luawt_typeToStr<WText>(), "bool", NULL};
-static const char* const* const luawt_WText_setInternalPathEncoding_args[] = {WText_setInternalPathEncoding_args0, NULL};
-
-int luawt_WText_setInternalPathEncoding(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WText_setInternalPathEncoding_args);
-    WText* self = luawt_checkFromLua<WText>(L, 1);
-    if (index == 0) {
-        bool enabled = lua_toboolean(L, 2);
-        self->setInternalPathEncoding(enabled);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WText.setInternalPathEncoding");
-    }
-}
+BIND_METHOD(WText, hasInternalPathEncoding)
+BIND_METHOD(WText, refresh)
+BIND_METHOD(WText, setInternalPathEncoding)
+BIND_METHOD(WText, setText)
+BIND_METHOD(WText, setWordWrap)
+BIND_METHOD(WText, text)
+BIND_METHOD(WText, wordWrap)
 
 ADD_SIGNAL(keyWentDown, WText, Wt::WKeyEvent)
 ADD_SIGNAL(keyPressed, WText, Wt::WKeyEvent)
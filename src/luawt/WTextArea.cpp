@@ -22,7 +22,7 @@ int luawt_WTextArea_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTextArea");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -32,20 +32,18 @@ int luawt_WTextArea_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString content = Wt::WString(raw1);
+        Wt::WString content = luawt_toWString(L, 1);
         WTextArea* l_result = new WTextArea(content);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTextArea");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString content = Wt::WString(raw1);
+        Wt::WString content = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WTextArea* l_result = new WTextArea(content, parent);
@@ -109,7 +107,7 @@ int luawt_WTextArea_text(lua_State* L) {
     WTextArea* self = luawt_checkFromLua<WTextArea>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->text();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTextArea.text");
@@ -123,8 +121,7 @@ int luawt_WTextArea_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTextArea_setText_args);
     WTextArea* self = luawt_checkFromLua<WTextArea>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -140,7 +137,7 @@ int luawt_WTextArea_selectedText(lua_State* L) {
     WTextArea* self = luawt_checkFromLua<WTextArea>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->selectedText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTextArea.selectedText");
@@ -199,8 +196,7 @@ int luawt_WTextArea_setValueText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTextArea_setValueText_args);
     WTextArea* self = luawt_checkFromLua<WTextArea>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setValueText(text);
         return 0;
     } else {
@@ -231,7 +227,7 @@ int luawt_WTextArea_valueText(lua_State* L) {
     WTextArea* self = luawt_checkFromLua<WTextArea>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->valueText();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTextArea.valueText");
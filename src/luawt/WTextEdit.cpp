@@ -23,7 +23,7 @@ int luawt_WTextEdit_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTextEdit");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -33,20 +33,18 @@ int luawt_WTextEdit_make(lua_State* L) {
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         WTextEdit* l_result = new WTextEdit(text);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTextEdit");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString text = Wt::WString(raw1);
+        Wt::WString text = luawt_toWString(L, 1);
         Wt::WContainerWidget* parent =
             luawt_checkFromLua<Wt::WContainerWidget>(L, 2);
         WTextEdit* l_result = new WTextEdit(text, parent);
@@ -64,8 +62,7 @@ int luawt_WTextEdit_setText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTextEdit_setText_args);
     WTextEdit* self = luawt_checkFromLua<WTextEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setText(text);
         return 0;
     } else {
@@ -80,8 +77,7 @@ int luawt_WTextEdit_setExtraPlugins(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTextEdit_setExtraPlugins_args);
     WTextEdit* self = luawt_checkFromLua<WTextEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string plugins = std::string(raw2);
+        std::string plugins = luawt_toStdString(L, 2);
         self->setExtraPlugins(plugins);
         return 0;
     } else {
@@ -97,7 +93,7 @@ int luawt_WTextEdit_extraPlugins(lua_State* L) {
     WTextEdit* self = luawt_checkFromLua<WTextEdit>(L, 1);
     if (index == 0) {
         std::string const l_result = self->extraPlugins();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTextEdit.extraPlugins");
@@ -112,7 +108,7 @@ int luawt_WTextEdit_styleSheet(lua_State* L) {
     WTextEdit* self = luawt_checkFromLua<WTextEdit>(L, 1);
     if (index == 0) {
         std::string const l_result = self->styleSheet();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTextEdit.styleSheet");
@@ -127,8 +123,7 @@ int luawt_WTextEdit_setToolBar(lua_State* L) {
     WTextEdit* self = luawt_checkFromLua<WTextEdit>(L, 1);
     if (index == 0) {
         int i = lua_tointeger(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string config = std::string(raw3);
+        std::string config = luawt_toStdString(L, 3);
         self->setToolBar(i, config);
         return 0;
     } else {
@@ -161,8 +156,7 @@ int luawt_WTextEdit_setStyleSheet(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTextEdit_setStyleSheet_args);
     WTextEdit* self = luawt_checkFromLua<WTextEdit>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string uri = std::string(raw2);
+        std::string uri = luawt_toStdString(L, 2);
         self->setStyleSheet(uri);
         return 0;
     } else {
@@ -179,7 +173,7 @@ int luawt_WTextEdit_toolBar(lua_State* L) {
     if (index == 0) {
         int i = lua_tointeger(L, 2);
         std::string const l_result = self->toolBar(i);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTextEdit.toolBar");
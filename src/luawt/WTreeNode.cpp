@@ -17,20 +17,18 @@ static const char* const* const luawt_WTreeNode_make_args[] = {WTreeNode_make_ar
 int luawt_WTreeNode_make(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTreeNode_make_args);
     if (index == 0) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString labelText = Wt::WString(raw1);
+        Wt::WString labelText = luawt_toWString(L, 1);
         WTreeNode* l_result = new WTreeNode(labelText);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeNode");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString labelText = Wt::WString(raw1);
+        Wt::WString labelText = luawt_toWString(L, 1);
         Wt::WIconPair* labelIcon =
             luawt_checkFromLua<Wt::WIconPair>(L, 2);
         WTreeNode* l_result = new WTreeNode(labelText, labelIcon);
@@ -39,12 +37,11 @@ int luawt_WTreeNode_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeNode");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString labelText = Wt::WString(raw1);
+        Wt::WString labelText = luawt_toWString(L, 1);
         Wt::WIconPair* labelIcon =
             luawt_checkFromLua<Wt::WIconPair>(L, 2);
         Wt::WTreeNode* parentNode =
@@ -55,7 +52,7 @@ int luawt_WTreeNode_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeNode");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else {
@@ -354,8 +351,7 @@ int luawt_WTreeNode_setImagePack(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTreeNode_setImagePack_args);
     WTreeNode* self = luawt_checkFromLua<WTreeNode>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         self->setImagePack(url);
         return 0;
     } else {
@@ -25,7 +25,7 @@ int luawt_WTreeTable_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeTable");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -94,8 +94,7 @@ int luawt_WTreeTable_setTreeRoot(lua_State* L) {
     if (index == 0) {
         Wt::WTreeTableNode* root =
             luawt_checkFromLua<Wt::WTreeTableNode>(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString header = Wt::WString(raw3);
+        Wt::WString header = luawt_toWString(L, 3);
         self->setTreeRoot(root, header);
         return 0;
     } else {
@@ -127,8 +126,7 @@ int luawt_WTreeTable_setTree(lua_State* L) {
     if (index == 0) {
         Wt::WTree* tree =
             luawt_checkFromLua<Wt::WTree>(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString header = Wt::WString(raw3);
+        Wt::WString header = luawt_toWString(L, 3);
         self->setTree(tree, header);
         return 0;
     } else {
@@ -159,8 +157,7 @@ int luawt_WTreeTable_addColumn(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTreeTable_addColumn_args);
     WTreeTable* self = luawt_checkFromLua<WTreeTable>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString header = Wt::WString(raw2);
+        Wt::WString header = luawt_toWString(L, 2);
         double raw3 = lua_tonumber(L, 3);
         Wt::WLength width = Wt::WLength(raw3);
         self->addColumn(header, width);
@@ -18,20 +18,18 @@ static const char* const* const luawt_WTreeTableNode_make_args[] = {WTreeTableNo
 int luawt_WTreeTableNode_make(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WTreeTableNode_make_args);
     if (index == 0) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString labelText = Wt::WString(raw1);
+        Wt::WString labelText = luawt_toWString(L, 1);
         WTreeTableNode* l_result = new WTreeTableNode(labelText);
         MyApplication* app = MyApplication::instance();
         if (!app) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeTableNode");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString labelText = Wt::WString(raw1);
+        Wt::WString labelText = luawt_toWString(L, 1);
         Wt::WIconPair* labelIcon =
             luawt_checkFromLua<Wt::WIconPair>(L, 2);
         WTreeTableNode* l_result = new WTreeTableNode(labelText, labelIcon);
@@ -40,12 +38,11 @@ int luawt_WTreeTableNode_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeTableNode");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
-        char const* raw1 = lua_tostring(L, 1);
-        Wt::WString labelText = Wt::WString(raw1);
+        Wt::WString labelText = luawt_toWString(L, 1);
         Wt::WIconPair* labelIcon =
             luawt_checkFromLua<Wt::WIconPair>(L, 2);
         Wt::WTreeTableNode* parentNode =
@@ -56,7 +53,7 @@ int luawt_WTreeTableNode_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeTableNode");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else {
@@ -21,7 +21,7 @@ int luawt_WTreeView_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WTreeView");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -104,8 +104,7 @@ int luawt_WTreeView_setColumnFormat(lua_State* L) {
     WTreeView* self = luawt_checkFromLua<WTreeView>(L, 1);
     if (index == 0) {
         int column = lua_tointeger(L, 2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString format = Wt::WString(raw3);
+        Wt::WString format = luawt_toWString(L, 3);
         self->setColumnFormat(column, format);
         return 0;
     } else {
@@ -246,7 +245,7 @@ int luawt_WTreeView_columnFormat(lua_State* L) {
     if (index == 0) {
         int column = lua_tointeger(L, 2);
         Wt::WString l_result = self->columnFormat(column);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WTreeView.columnFormat");
@@ -26,7 +26,7 @@ int luawt_WValidationStatus_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WValidationStatus");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -40,7 +40,7 @@ int luawt_WValidationStatus_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WValidationStatus");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
@@ -56,7 +56,7 @@ int luawt_WValidationStatus_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WValidationStatus");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 3) {
@@ -74,7 +74,7 @@ int luawt_WValidationStatus_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WValidationStatus");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 4) {
@@ -20,7 +20,7 @@ int luawt_WVideo_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WVideo");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -42,7 +42,7 @@ int luawt_WVideo_jsVideoRef(lua_State* L) {
     WVideo* self = luawt_checkFromLua<WVideo>(L, 1);
     if (index == 0) {
         std::string l_result = self->jsVideoRef();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WVideo.jsVideoRef");
@@ -74,8 +74,7 @@ int luawt_WVideo_setPoster(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WVideo_setPoster_args);
     WVideo* self = luawt_checkFromLua<WVideo>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         self->setPoster(url);
         return 0;
     } else {
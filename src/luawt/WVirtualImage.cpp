@@ -24,7 +24,7 @@ int luawt_WVirtualImage_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WVirtualImage");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 1) {
@@ -39,7 +39,7 @@ int luawt_WVirtualImage_make(lua_State* L) {
             delete l_result;
             throw std::logic_error("No WApplication when creating WVirtualImage");
         }
-        app->root()->addWidget(l_result);
+        luawt_defaultParent(app)->addWidget(l_result);
         luawt_toLua(L, l_result);
         return 1;
     } else if (index == 2) {
@@ -44,8 +44,7 @@ int luawt_WWebWidget_doJavaScript(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_doJavaScript_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string javascript = std::string(raw2);
+        std::string javascript = luawt_toStdString(L, 2);
         self->doJavaScript(javascript);
         return 0;
     } else {
@@ -108,10 +107,9 @@ int luawt_WWebWidget_resolveRelativeUrl(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_resolveRelativeUrl_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string url = std::string(raw2);
+        std::string url = luawt_toStdString(L, 2);
         std::string l_result = self->resolveRelativeUrl(url);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWebWidget.resolveRelativeUrl");
@@ -204,7 +202,7 @@ int luawt_WWebWidget_styleClass(lua_State* L) {
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
         Wt::WString l_result = self->styleClass();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWebWidget.styleClass");
@@ -218,8 +216,7 @@ int luawt_WWebWidget_find(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_find_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         Wt::WWidget* l_result = self->find(name);
         luawt_toLua(L, l_result);
         return 1;
@@ -460,7 +457,7 @@ int luawt_WWebWidget_id(lua_State* L) {
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
         std::string const l_result = self->id();
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWebWidget.id");
@@ -534,10 +531,9 @@ int luawt_WWebWidget_attributeValue(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_attributeValue_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         Wt::WString l_result = self->attributeValue(name);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWebWidget.attributeValue");
@@ -602,10 +598,9 @@ int luawt_WWebWidget_javaScriptMember(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_javaScriptMember_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
+        std::string name = luawt_toStdString(L, 2);
         std::string l_result = self->javaScriptMember(name);
-        lua_pushstring(L, l_result.c_str());
+        luawt_pushString(L, l_result);
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWebWidget.javaScriptMember");
@@ -635,7 +630,7 @@ int luawt_WWebWidget_toolTip(lua_State* L) {
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->toolTip();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWebWidget.toolTip");
@@ -794,8 +789,7 @@ int luawt_WWebWidget_setId(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_setId_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string id = std::string(raw2);
+        std::string id = luawt_toStdString(L, 2);
         self->setId(id);
         return 0;
     } else {
@@ -826,8 +820,7 @@ int luawt_WWebWidget_hasStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_hasStyleClass_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool l_result = self->hasStyleClass(styleClass);
         lua_pushboolean(L, l_result);
         return 1;
@@ -843,8 +836,7 @@ int luawt_WWebWidget_findById(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_findById_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string id = std::string(raw2);
+        std::string id = luawt_toStdString(L, 2);
         Wt::WWidget* l_result = self->findById(id);
         luawt_toLua(L, l_result);
         return 1;
@@ -876,13 +868,11 @@ int luawt_WWebWidget_setToolTip(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_setToolTip_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setToolTip(text);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -905,17 +895,15 @@ int luawt_WWebWidget_escapeText(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_escapeText_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::WString l_result = self->escapeText(text);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         bool newlinesToo = lua_toboolean(L, 3);
         Wt::WString l_result = self->escapeText(text, newlinesToo);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWebWidget.escapeText");
@@ -944,10 +932,8 @@ int luawt_WWebWidget_setJavaScriptMember(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_setJavaScriptMember_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string value = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string value = luawt_toStdString(L, 3);
         self->setJavaScriptMember(name, value);
         return 0;
     } else {
@@ -963,13 +949,11 @@ int luawt_WWebWidget_removeStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_removeStyleClass_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->removeStyleClass(styleClass);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool force = lua_toboolean(L, 3);
         self->removeStyleClass(styleClass, force);
         return 0;
@@ -999,8 +983,7 @@ int luawt_WWebWidget_setStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_setStyleClass_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->setStyleClass(styleClass);
         return 0;
     } else {
@@ -1061,13 +1044,11 @@ int luawt_WWebWidget_addStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_addStyleClass_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->addStyleClass(styleClass);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool force = lua_toboolean(L, 3);
         self->addStyleClass(styleClass, force);
         return 0;
@@ -1083,10 +1064,8 @@ int luawt_WWebWidget_setAttributeValue(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_setAttributeValue_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString value = Wt::WString(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        Wt::WString value = luawt_toWString(L, 3);
         self->setAttributeValue(name, value);
         return 0;
     } else {
@@ -1101,10 +1080,8 @@ int luawt_WWebWidget_callJavaScriptMember(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWebWidget_callJavaScriptMember_args);
     WWebWidget* self = luawt_checkFromLua<WWebWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string args = std::string(raw3);
+        std::string name = luawt_toStdString(L, 2);
+        std::string args = luawt_toStdString(L, 3);
         self->callJavaScriptMember(name, args);
         return 0;
     } else {
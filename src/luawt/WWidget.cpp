@@ -6,6 +6,7 @@
 
 #include "enums.hpp"
 #include "globals.hpp"
+#include "marshal.hpp"
 
 int luawt_WWidget_id(lua_State* L) {
     WWidget* widget = luawt_checkFromLua<WWidget>(L, -1);
@@ -14,54 +15,6 @@ int luawt_WWidget_id(lua_State* L) {
     return 1;
 }
 
-static const char* WWidget_load_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_load_args[] = {WWidget_load_args0, NULL};
-
-int luawt_WWidget_load(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_load_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        self->load();
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.load");
-    }
-}
-
-static const char* WWidget_doJavaScript_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_doJavaScript_args[] = {WWidget_doJavaScript_args0, NULL};
-
-int luawt_WWidget_doJavaScript(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_doJavaScript_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string js = std::string(raw2);
-        self->doJavaScript(js);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.doJavaScript");
-    }
-}
-
-static const char* WWidget_callJavaScriptMember_args0[] = {luawt_typeToStr<WWidget>(), "char const *", "char const *", NULL};
-static const char* const* const luawt_WWidget_callJavaScriptMember_args[] = {WWidget_callJavaScriptMember_args0, NULL};
-
-int luawt_WWidget_callJavaScriptMember(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_callJavaScriptMember_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string args = std::string(raw3);
-        self->callJavaScriptMember(name, args);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.callJavaScriptMember");
-    }
-}
-
 static const char* WWidget_positionAt_args0[] = {luawt_typeToStr<WWidget>(), luawt_typeToStr<Wt::WWidget>(), NULL};
 static const char* WWidget_positionAt_args1[] = {luawt_typeToStr<WWidget>(), luawt_typeToStr<Wt::WWidget>(), "enum", NULL};
 static const char* const* const luawt_WWidget_positionAt_args[] = {WWidget_positionAt_args0, WWidget_positionAt_args1, NULL};
@@ -91,24 +44,6 @@ int luawt_WWidget_positionAt(lua_State* L) {
     }
 }
 
-static const char* WWidget_setMinimumSize_args0[] = {luawt_typeToStr<WWidget>(), "double", "double", NULL};
-static const char* const* const luawt_WWidget_setMinimumSize_args[] = {WWidget_setMinimumSize_args0, NULL};
-
-int luawt_WWidget_setMinimumSize(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setMinimumSize_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        double raw2 = lua_tonumber(L, 2);
-        Wt::WLength width = Wt::WLength(raw2);
-        double raw3 = lua_tonumber(L, 3);
-        Wt::WLength height = Wt::WLength(raw3);
-        self->setMinimumSize(width, height);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setMinimumSize");
-    }
-}
-
 static const char* WWidget_floatSide_args0[] = {luawt_typeToStr<WWidget>(), NULL};
 static const char* const* const luawt_WWidget_floatSide_args[] = {WWidget_floatSide_args0, NULL};
 
@@ -124,220 +59,6 @@ int luawt_WWidget_floatSide(lua_State* L) {
     }
 }
 
-static const char* WWidget_jsRef_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_jsRef_args[] = {WWidget_jsRef_args0, NULL};
-
-int luawt_WWidget_jsRef(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_jsRef_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        std::string l_result = self->jsRef();
-        lua_pushstring(L, l_result.c_str());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.jsRef");
-    }
-}
-
-static const char* WWidget_height_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_height_args[] = {WWidget_height_args0, NULL};
-
-int luawt_WWidget_height(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_height_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->height();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.height");
-    }
-}
-
-static const char* WWidget_hiddenKeepsGeometry_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_hiddenKeepsGeometry_args[] = {WWidget_hiddenKeepsGeometry_args0, NULL};
-
-int luawt_WWidget_hiddenKeepsGeometry(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_hiddenKeepsGeometry_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->hiddenKeepsGeometry();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.hiddenKeepsGeometry");
-    }
-}
-
-static const char* WWidget_minimumHeight_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_minimumHeight_args[] = {WWidget_minimumHeight_args0, NULL};
-
-int luawt_WWidget_minimumHeight(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_minimumHeight_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->minimumHeight();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.minimumHeight");
-    }
-}
-
-static const char* WWidget_loaded_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_loaded_args[] = {WWidget_loaded_args0, NULL};
-
-int luawt_WWidget_loaded(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_loaded_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->loaded();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.loaded");
-    }
-}
-
-static const char* WWidget_setMaximumSize_args0[] = {luawt_typeToStr<WWidget>(), "double", "double", NULL};
-static const char* const* const luawt_WWidget_setMaximumSize_args[] = {WWidget_setMaximumSize_args0, NULL};
-
-int luawt_WWidget_setMaximumSize(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setMaximumSize_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        double raw2 = lua_tonumber(L, 2);
-        Wt::WLength width = Wt::WLength(raw2);
-        double raw3 = lua_tonumber(L, 3);
-        Wt::WLength height = Wt::WLength(raw3);
-        self->setMaximumSize(width, height);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setMaximumSize");
-    }
-}
-
-static const char* WWidget_setWidth_args0[] = {luawt_typeToStr<WWidget>(), "double", NULL};
-static const char* const* const luawt_WWidget_setWidth_args[] = {WWidget_setWidth_args0, NULL};
-
-int luawt_WWidget_setWidth(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setWidth_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        double raw2 = lua_tonumber(L, 2);
-        Wt::WLength width = Wt::WLength(raw2);
-        self->setWidth(width);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setWidth");
-    }
-}
-
-static const char* WWidget_find_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_find_args[] = {WWidget_find_args0, NULL};
-
-int luawt_WWidget_find(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_find_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        Wt::WWidget* l_result = self->find(name);
-        luawt_toLua(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.find");
-    }
-}
-
-static const char* WWidget_setTabIndex_args0[] = {luawt_typeToStr<WWidget>(), "int", NULL};
-static const char* const* const luawt_WWidget_setTabIndex_args[] = {WWidget_setTabIndex_args0, NULL};
-
-int luawt_WWidget_setTabIndex(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setTabIndex_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        int index = lua_tointeger(L, 2);
-        self->setTabIndex(index);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setTabIndex");
-    }
-}
-
-static const char* WWidget_isInline_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_isInline_args[] = {WWidget_isInline_args0, NULL};
-
-int luawt_WWidget_isInline(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_isInline_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->isInline();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.isInline");
-    }
-}
-
-static const char* WWidget_layoutSizeAware_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_layoutSizeAware_args[] = {WWidget_layoutSizeAware_args0, NULL};
-
-int luawt_WWidget_layoutSizeAware(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_layoutSizeAware_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->layoutSizeAware();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.layoutSizeAware");
-    }
-}
-
-static const char* WWidget_hide_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_hide_args[] = {WWidget_hide_args0, NULL};
-
-int luawt_WWidget_hide(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_hide_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        self->hide();
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.hide");
-    }
-}
-
-static const char* WWidget_disable_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_disable_args[] = {WWidget_disable_args0, NULL};
-
-int luawt_WWidget_disable(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_disable_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        self->disable();
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.disable");
-    }
-}
-
-static const char* WWidget_inlineCssStyle_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_inlineCssStyle_args[] = {WWidget_inlineCssStyle_args0, NULL};
-
-int luawt_WWidget_inlineCssStyle(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_inlineCssStyle_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        std::string l_result = self->inlineCssStyle();
-        lua_pushstring(L, l_result.c_str());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.inlineCssStyle");
-    }
-}
-
 static const char* WWidget_setClearSides_args0[] = {luawt_typeToStr<WWidget>(), "enum", NULL};
 static const char* const* const luawt_WWidget_setClearSides_args[] = {WWidget_setClearSides_args0, NULL};
 
@@ -359,21 +80,6 @@ int luawt_WWidget_setClearSides(lua_State* L) {
     }
 }
 
-static const char* WWidget_isRendered_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_isRendered_args[] = {WWidget_isRendered_args0, NULL};
-
-int luawt_WWidget_isRendered(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_isRendered_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->isRendered();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.isRendered");
-    }
-}
-
 static const char* WWidget_setOffsets_args0[] = {luawt_typeToStr<WWidget>(), "double", NULL};
 static const char* WWidget_setOffsets_args1[] = {luawt_typeToStr<WWidget>(), "double", "enum", NULL};
 static const char* const* const luawt_WWidget_setOffsets_args[] = {WWidget_setOffsets_args0, WWidget_setOffsets_args1, NULL};
@@ -403,21 +109,6 @@ int luawt_WWidget_setOffsets(lua_State* L) {
     }
 }
 
-static const char* WWidget_styleClass_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_styleClass_args[] = {WWidget_styleClass_args0, NULL};
-
-int luawt_WWidget_styleClass(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_styleClass_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WString l_result = self->styleClass();
-        lua_pushstring(L, l_result.toUTF8().c_str());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.styleClass");
-    }
-}
-
 static const char* WWidget_tr_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
 static const char* const* const luawt_WWidget_tr_args[] = {WWidget_tr_args0, NULL};
 
@@ -425,31 +116,15 @@ int luawt_WWidget_tr(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_tr_args);
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string key = std::string(raw2);
+        std::string key = luawt_toStdString(L, 2);
         Wt::WString l_result = self->tr(key);
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWidget.tr");
     }
 }
 
-static const char* WWidget_setPopup_args0[] = {luawt_typeToStr<WWidget>(), "bool", NULL};
-static const char* const* const luawt_WWidget_setPopup_args[] = {WWidget_setPopup_args0, NULL};
-
-int luawt_WWidget_setPopup(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setPopup_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool popup = lua_toboolean(L, 2);
-        self->setPopup(popup);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setPopup");
-    }
-}
-
 static const char* WWidget_setFloatSide_args0[] = {luawt_typeToStr<WWidget>(), "enum", NULL};
 static const char* const* const luawt_WWidget_setFloatSide_args[] = {WWidget_setFloatSide_args0, NULL};
 
@@ -471,21 +146,6 @@ int luawt_WWidget_setFloatSide(lua_State* L) {
     }
 }
 
-static const char* WWidget_width_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_width_args[] = {WWidget_width_args0, NULL};
-
-int luawt_WWidget_width(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_width_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->width();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.width");
-    }
-}
-
 static const char* WWidget_verticalAlignment_args0[] = {luawt_typeToStr<WWidget>(), NULL};
 static const char* const* const luawt_WWidget_verticalAlignment_args[] = {WWidget_verticalAlignment_args0, NULL};
 
@@ -501,24 +161,6 @@ int luawt_WWidget_verticalAlignment(lua_State* L) {
     }
 }
 
-static const char* WWidget_resize_args0[] = {luawt_typeToStr<WWidget>(), "double", "double", NULL};
-static const char* const* const luawt_WWidget_resize_args[] = {WWidget_resize_args0, NULL};
-
-int luawt_WWidget_resize(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_resize_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        double raw2 = lua_tonumber(L, 2);
-        Wt::WLength width = Wt::WLength(raw2);
-        double raw3 = lua_tonumber(L, 3);
-        Wt::WLength height = Wt::WLength(raw3);
-        self->resize(width, height);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.resize");
-    }
-}
-
 static const char* WWidget_positionScheme_args0[] = {luawt_typeToStr<WWidget>(), NULL};
 static const char* const* const luawt_WWidget_positionScheme_args[] = {WWidget_positionScheme_args0, NULL};
 
@@ -534,174 +176,6 @@ int luawt_WWidget_positionScheme(lua_State* L) {
     }
 }
 
-static const char* WWidget_show_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_show_args[] = {WWidget_show_args0, NULL};
-
-int luawt_WWidget_show(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_show_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        self->show();
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.show");
-    }
-}
-
-static const char* WWidget_lineHeight_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_lineHeight_args[] = {WWidget_lineHeight_args0, NULL};
-
-int luawt_WWidget_lineHeight(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_lineHeight_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->lineHeight();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.lineHeight");
-    }
-}
-
-static const char* WWidget_tabIndex_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_tabIndex_args[] = {WWidget_tabIndex_args0, NULL};
-
-int luawt_WWidget_tabIndex(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_tabIndex_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        int l_result = self->tabIndex();
-        lua_pushinteger(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.tabIndex");
-    }
-}
-
-static const char* WWidget_isHidden_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_isHidden_args[] = {WWidget_isHidden_args0, NULL};
-
-int luawt_WWidget_isHidden(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_isHidden_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->isHidden();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.isHidden");
-    }
-}
-
-static const char* WWidget_setSelectable_args0[] = {luawt_typeToStr<WWidget>(), "bool", NULL};
-static const char* const* const luawt_WWidget_setSelectable_args[] = {WWidget_setSelectable_args0, NULL};
-
-int luawt_WWidget_setSelectable(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setSelectable_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool selectable = lua_toboolean(L, 2);
-        self->setSelectable(selectable);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setSelectable");
-    }
-}
-
-static const char* WWidget_hasStyleClass_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_hasStyleClass_args[] = {WWidget_hasStyleClass_args0, NULL};
-
-int luawt_WWidget_hasStyleClass(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_hasStyleClass_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
-        bool l_result = self->hasStyleClass(styleClass);
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.hasStyleClass");
-    }
-}
-
-static const char* WWidget_enable_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_enable_args[] = {WWidget_enable_args0, NULL};
-
-int luawt_WWidget_enable(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_enable_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        self->enable();
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.enable");
-    }
-}
-
-static const char* WWidget_minimumWidth_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_minimumWidth_args[] = {WWidget_minimumWidth_args0, NULL};
-
-int luawt_WWidget_minimumWidth(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_minimumWidth_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->minimumWidth();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.minimumWidth");
-    }
-}
-
-static const char* WWidget_attributeValue_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_attributeValue_args[] = {WWidget_attributeValue_args0, NULL};
-
-int luawt_WWidget_attributeValue(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_attributeValue_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        Wt::WString l_result = self->attributeValue(name);
-        lua_pushstring(L, l_result.toUTF8().c_str());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.attributeValue");
-    }
-}
-
-static const char* WWidget_parent_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_parent_args[] = {WWidget_parent_args0, NULL};
-
-int luawt_WWidget_parent(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_parent_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WWidget* l_result = self->parent();
-        luawt_toLua(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.parent");
-    }
-}
-
-static const char* WWidget_stopAcceptDrops_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_stopAcceptDrops_args[] = {WWidget_stopAcceptDrops_args0, NULL};
-
-int luawt_WWidget_stopAcceptDrops(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_stopAcceptDrops_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string mimeType = std::string(raw2);
-        self->stopAcceptDrops(mimeType);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.stopAcceptDrops");
-    }
-}
-
 static const char* WWidget_setPositionScheme_args0[] = {luawt_typeToStr<WWidget>(), "enum", NULL};
 static const char* const* const luawt_WWidget_setPositionScheme_args[] = {WWidget_setPositionScheme_args0, NULL};
 
@@ -723,53 +197,6 @@ int luawt_WWidget_setPositionScheme(lua_State* L) {
     }
 }
 
-static const char* WWidget_maximumHeight_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_maximumHeight_args[] = {WWidget_maximumHeight_args0, NULL};
-
-int luawt_WWidget_maximumHeight(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_maximumHeight_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->maximumHeight();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.maximumHeight");
-    }
-}
-
-static const char* WWidget_javaScriptMember_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_javaScriptMember_args[] = {WWidget_javaScriptMember_args0, NULL};
-
-int luawt_WWidget_javaScriptMember(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_javaScriptMember_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        std::string l_result = self->javaScriptMember(name);
-        lua_pushstring(L, l_result.c_str());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.javaScriptMember");
-    }
-}
-
-static const char* WWidget_verticalAlignmentLength_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_verticalAlignmentLength_args[] = {WWidget_verticalAlignmentLength_args0, NULL};
-
-int luawt_WWidget_verticalAlignmentLength(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_verticalAlignmentLength_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->verticalAlignmentLength();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.verticalAlignmentLength");
-    }
-}
-
 static const char* WWidget_toolTip_args0[] = {luawt_typeToStr<WWidget>(), NULL};
 static const char* const* const luawt_WWidget_toolTip_args[] = {WWidget_toolTip_args0, NULL};
 
@@ -778,7 +205,7 @@ int luawt_WWidget_toolTip(lua_State* L) {
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
         Wt::WString const& l_result = self->toolTip();
-        lua_pushstring(L, l_result.toUTF8().c_str());
+        luawt_pushString(L, l_result.toUTF8());
         return 1;
     } else {
         return luaL_error(L, "Wrong arguments for WWidget.toolTip");
@@ -793,15 +220,12 @@ int luawt_WWidget_acceptDrops(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_acceptDrops_args);
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string mimeType = std::string(raw2);
+        std::string mimeType = luawt_toStdString(L, 2);
         self->acceptDrops(mimeType);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string mimeType = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString hoverStyleClass = Wt::WString(raw3);
+        std::string mimeType = luawt_toStdString(L, 2);
+        Wt::WString hoverStyleClass = luawt_toWString(L, 3);
         self->acceptDrops(mimeType, hoverStyleClass);
         return 0;
     } else {
@@ -872,21 +296,6 @@ int luawt_WWidget_setMargin(lua_State* L) {
     }
 }
 
-static const char* WWidget_setInline_args0[] = {luawt_typeToStr<WWidget>(), "bool", NULL};
-static const char* const* const luawt_WWidget_setInline_args[] = {WWidget_setInline_args0, NULL};
-
-int luawt_WWidget_setInline(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setInline_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool inlined = lua_toboolean(L, 2);
-        self->setInline(inlined);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setInline");
-    }
-}
-
 static const char* WWidget_offset_args0[] = {luawt_typeToStr<WWidget>(), "enum", NULL};
 static const char* const* const luawt_WWidget_offset_args[] = {WWidget_offset_args0, NULL};
 
@@ -931,8 +340,7 @@ int luawt_WWidget_setId(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setId_args);
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string id = std::string(raw2);
+        std::string id = luawt_toStdString(L, 2);
         self->setId(id);
         return 0;
     } else {
@@ -940,70 +348,6 @@ int luawt_WWidget_setId(lua_State* L) {
     }
 }
 
-static const char* WWidget_setLineHeight_args0[] = {luawt_typeToStr<WWidget>(), "double", NULL};
-static const char* const* const luawt_WWidget_setLineHeight_args[] = {WWidget_setLineHeight_args0, NULL};
-
-int luawt_WWidget_setLineHeight(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setLineHeight_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        double raw2 = lua_tonumber(L, 2);
-        Wt::WLength height = Wt::WLength(raw2);
-        self->setLineHeight(height);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setLineHeight");
-    }
-}
-
-static const char* WWidget_setHeight_args0[] = {luawt_typeToStr<WWidget>(), "double", NULL};
-static const char* const* const luawt_WWidget_setHeight_args[] = {WWidget_setHeight_args0, NULL};
-
-int luawt_WWidget_setHeight(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setHeight_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        double raw2 = lua_tonumber(L, 2);
-        Wt::WLength height = Wt::WLength(raw2);
-        self->setHeight(height);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setHeight");
-    }
-}
-
-static const char* WWidget_findById_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_findById_args[] = {WWidget_findById_args0, NULL};
-
-int luawt_WWidget_findById(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_findById_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string id = std::string(raw2);
-        Wt::WWidget* l_result = self->findById(id);
-        luawt_toLua(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.findById");
-    }
-}
-
-static const char* WWidget_maximumWidth_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_maximumWidth_args[] = {WWidget_maximumWidth_args0, NULL};
-
-int luawt_WWidget_maximumWidth(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_maximumWidth_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        Wt::WLength l_result = self->maximumWidth();
-        lua_pushnumber(L, l_result.value());
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.maximumWidth");
-    }
-}
-
 static const char* WWidget_setToolTip_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
 static const char* WWidget_setToolTip_args1[] = {luawt_typeToStr<WWidget>(), "char const *", "enum", NULL};
 static const char* const* const luawt_WWidget_setToolTip_args[] = {WWidget_setToolTip_args0, WWidget_setToolTip_args1, NULL};
@@ -1012,13 +356,11 @@ int luawt_WWidget_setToolTip(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setToolTip_args);
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         self->setToolTip(text);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString text = Wt::WString(raw2);
+        Wt::WString text = luawt_toWString(L, 2);
         Wt::TextFormat textFormat = static_cast<Wt::TextFormat>(luawt_getEnum(
                     L,
                     luawt_enum_TextFormat_str,
@@ -1033,39 +375,6 @@ int luawt_WWidget_setToolTip(lua_State* L) {
     }
 }
 
-static const char* WWidget_isPopup_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_isPopup_args[] = {WWidget_isPopup_args0, NULL};
-
-int luawt_WWidget_isPopup(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_isPopup_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->isPopup();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.isPopup");
-    }
-}
-
-static const char* WWidget_setJavaScriptMember_args0[] = {luawt_typeToStr<WWidget>(), "char const *", "char const *", NULL};
-static const char* const* const luawt_WWidget_setJavaScriptMember_args[] = {WWidget_setJavaScriptMember_args0, NULL};
-
-int luawt_WWidget_setJavaScriptMember(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setJavaScriptMember_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        std::string value = std::string(raw3);
-        self->setJavaScriptMember(name, value);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setJavaScriptMember");
-    }
-}
-
 static const char* WWidget_removeStyleClass_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
 static const char* WWidget_removeStyleClass_args1[] = {luawt_typeToStr<WWidget>(), "char const *", "bool", NULL};
 static const char* const* const luawt_WWidget_removeStyleClass_args[] = {WWidget_removeStyleClass_args0, WWidget_removeStyleClass_args1, NULL};
@@ -1074,13 +383,11 @@ int luawt_WWidget_removeStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_removeStyleClass_args);
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->removeStyleClass(styleClass);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool force = lua_toboolean(L, 3);
         self->removeStyleClass(styleClass, force);
         return 0;
@@ -1089,20 +396,6 @@ int luawt_WWidget_removeStyleClass(lua_State* L) {
     }
 }
 
-static const char* WWidget_refresh_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_refresh_args[] = {WWidget_refresh_args0, NULL};
-
-int luawt_WWidget_refresh(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_refresh_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        self->refresh();
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.refresh");
-    }
-}
-
 static const char* WWidget_setTabOrder_args0[] = {luawt_typeToStr<WWidget>(), luawt_typeToStr<Wt::WWidget>(), luawt_typeToStr<Wt::WWidget>(), NULL};
 static const char* const* const luawt_WWidget_setTabOrder_args[] = {WWidget_setTabOrder_args0, NULL};
 
@@ -1121,67 +414,6 @@ int luawt_WWidget_setTabOrder(lua_State* L) {
     }
 }
 
-static const char* WWidget_setStyleClass_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
-static const char* const* const luawt_WWidget_setStyleClass_args[] = {WWidget_setStyleClass_args0, NULL};
-
-int luawt_WWidget_setStyleClass(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setStyleClass_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
-        self->setStyleClass(styleClass);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setStyleClass");
-    }
-}
-
-static const char* WWidget_setDisabled_args0[] = {luawt_typeToStr<WWidget>(), "bool", NULL};
-static const char* const* const luawt_WWidget_setDisabled_args[] = {WWidget_setDisabled_args0, NULL};
-
-int luawt_WWidget_setDisabled(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setDisabled_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool disabled = lua_toboolean(L, 2);
-        self->setDisabled(disabled);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setDisabled");
-    }
-}
-
-static const char* WWidget_setHiddenKeepsGeometry_args0[] = {luawt_typeToStr<WWidget>(), "bool", NULL};
-static const char* const* const luawt_WWidget_setHiddenKeepsGeometry_args[] = {WWidget_setHiddenKeepsGeometry_args0, NULL};
-
-int luawt_WWidget_setHiddenKeepsGeometry(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setHiddenKeepsGeometry_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool enabled = lua_toboolean(L, 2);
-        self->setHiddenKeepsGeometry(enabled);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setHiddenKeepsGeometry");
-    }
-}
-
-static const char* WWidget_isVisible_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_isVisible_args[] = {WWidget_isVisible_args0, NULL};
-
-int luawt_WWidget_isVisible(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_isVisible_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->isVisible();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.isVisible");
-    }
-}
-
 static const char* WWidget_addStyleClass_args0[] = {luawt_typeToStr<WWidget>(), "char const *", NULL};
 static const char* WWidget_addStyleClass_args1[] = {luawt_typeToStr<WWidget>(), "char const *", "bool", NULL};
 static const char* const* const luawt_WWidget_addStyleClass_args[] = {WWidget_addStyleClass_args0, WWidget_addStyleClass_args1, NULL};
@@ -1190,13 +422,11 @@ int luawt_WWidget_addStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_addStyleClass_args);
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         self->addStyleClass(styleClass);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool force = lua_toboolean(L, 3);
         self->addStyleClass(styleClass, force);
         return 0;
@@ -1205,24 +435,6 @@ int luawt_WWidget_addStyleClass(lua_State* L) {
     }
 }
 
-static const char* WWidget_setAttributeValue_args0[] = {luawt_typeToStr<WWidget>(), "char const *", "char const *", NULL};
-static const char* const* const luawt_WWidget_setAttributeValue_args[] = {WWidget_setAttributeValue_args0, NULL};
-
-int luawt_WWidget_setAttributeValue(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_setAttributeValue_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        std::string name = std::string(raw2);
-        char const* raw3 = lua_tostring(L, 3);
-        Wt::WString value = Wt::WString(raw3);
-        self->setAttributeValue(name, value);
-        return 0;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.setAttributeValue");
-    }
-}
-
 static const char* WWidget_toggleStyleClass_args0[] = {luawt_typeToStr<WWidget>(), "char const *", "bool", NULL};
 static const char* WWidget_toggleStyleClass_args1[] = {luawt_typeToStr<WWidget>(), "char const *", "bool", "bool", NULL};
 static const char* const* const luawt_WWidget_toggleStyleClass_args[] = {WWidget_toggleStyleClass_args0, WWidget_toggleStyleClass_args1, NULL};
@@ -1231,14 +443,12 @@ int luawt_WWidget_toggleStyleClass(lua_State* L) {
     int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_toggleStyleClass_args);
     WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
     if (index == 0) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool add = lua_toboolean(L, 3);
         self->toggleStyleClass(styleClass, add);
         return 0;
     } else if (index == 1) {
-        char const* raw2 = lua_tostring(L, 2);
-        Wt::WString styleClass = Wt::WString(raw2);
+        Wt::WString styleClass = luawt_toWString(L, 2);
         bool add = lua_toboolean(L, 3);
         bool force = lua_toboolean(L, 4);
         self->toggleStyleClass(styleClass, add, force);
@@ -1270,35 +480,58 @@ int luawt_WWidget_margin(lua_State* L) {
     }
 }
 
-static const char* WWidget_isDisabled_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_isDisabled_args[] = {WWidget_isDisabled_args0, NULL};
-
-int luawt_WWidget_isDisabled(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_isDisabled_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->isDisabled();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.isDisabled");
-    }
-}
-
-static const char* WWidget_isEnabled_args0[] = {luawt_typeToStr<WWidget>(), NULL};
-static const char* const* const luawt_WWidget_isEnabled_args[] = {WWidget_isEnabled_args0, NULL};
-
-int luawt_WWidget_isEnabled(lua_State* L) {
-    int index = luawt_getSuitableArgsGroup(L, luawt_WWidget_isEnabled_args);
-    WWidget* self = luawt_checkFromLua<WWidget>(L, 1);
-    if (index == 0) {
-        bool l_result = self->isEnabled();
-        lua_pushboolean(L, l_result);
-        return 1;
-    } else {
-        return luaL_error(L, "Wrong arguments for WWidget.isEnabled");
-    }
-}
+BIND_METHOD(WWidget, attributeValue)
+BIND_METHOD(WWidget, callJavaScriptMember)
+BIND_METHOD(WWidget, disable)
+BIND_METHOD(WWidget, doJavaScript)
+BIND_METHOD(WWidget, enable)
+BIND_METHOD(WWidget, find)
+BIND_METHOD(WWidget, findById)
+BIND_METHOD(WWidget, hasStyleClass)
+BIND_METHOD(WWidget, height)
+BIND_METHOD(WWidget, hiddenKeepsGeometry)
+BIND_METHOD(WWidget, hide)
+BIND_METHOD(WWidget, inlineCssStyle)
+BIND_METHOD(WWidget, isDisabled)
+BIND_METHOD(WWidget, isEnabled)
+BIND_METHOD(WWidget, isHidden)
+BIND_METHOD(WWidget, isInline)
+BIND_METHOD(WWidget, isPopup)
+BIND_METHOD(WWidget, isRendered)
+BIND_METHOD(WWidget, isVisible)
+BIND_METHOD(WWidget, javaScriptMember)
+BIND_METHOD(WWidget, jsRef)
+BIND_METHOD(WWidget, layoutSizeAware)
+BIND_METHOD(WWidget, lineHeight)
+BIND_METHOD(WWidget, load)
+BIND_METHOD(WWidget, loaded)
+BIND_METHOD(WWidget, maximumHeight)
+BIND_METHOD(WWidget, maximumWidth)
+BIND_METHOD(WWidget, minimumHeight)
+BIND_METHOD(WWidget, minimumWidth)
+BIND_METHOD(WWidget, parent)
+BIND_METHOD(WWidget, refresh)
+BIND_METHOD(WWidget, resize)
+BIND_METHOD(WWidget, setAttributeValue)
+BIND_METHOD(WWidget, setDisabled)
+BIND_METHOD(WWidget, setHeight)
+BIND_METHOD(WWidget, setHiddenKeepsGeometry)
+BIND_METHOD(WWidget, setInline)
+BIND_METHOD(WWidget, setJavaScriptMember)
+BIND_METHOD(WWidget, setLineHeight)
+BIND_METHOD(WWidget, setMaximumSize)
+BIND_METHOD(WWidget, setMinimumSize)
+BIND_METHOD(WWidget, setPopup)
+BIND_METHOD(WWidget, setSelectable)
+BIND_METHOD(WWidget, setStyleClass)
+BIND_METHOD(WWidget, setTabIndex)
+BIND_METHOD(WWidget, setWidth)
+BIND_METHOD(WWidget, show)
+BIND_METHOD(WWidget, stopAcceptDrops)
+BIND_METHOD(WWidget, styleClass)
+BIND_METHOD(WWidget, tabIndex)
+BIND_METHOD(WWidget, verticalAlignmentLength)
+BIND_METHOD(WWidget, width)
 
 static const luaL_Reg luawt_WWidget_methods[] = {
     METHOD(WWidget, id),
@@ -0,0 +1,122 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "boost-xtime.hpp"
+#include <boost/thread/mutex.hpp>
+#include <Wt/WApplication>
+#include <Wt/WEnvironment>
+#include <Wt/WText>
+
+#include "globals.hpp"
+#include "metrics.hpp"
+#include "server.hpp"
+
+luawt_Admission::luawt_Admission(const luawt_AdmissionOptions& options):
+    options_(options), bootstraps_(0), last_prune_(luawt_now()) {
+}
+
+bool luawt_Admission::enabled() const {
+    return options_.max_bootstraps || options_.max_sessions ||
+           options_.ip_rate;
+}
+
+/* Token bucket of the address. The mutex must be locked. */
+bool luawt_Admission::takeToken(const std::string& ip, long long now) {
+    if (!options_.ip_rate) {
+        return true;
+    }
+    // a full bucket is the same as no bucket, so drop full buckets
+    // from time to time to keep the map small
+    if (now - last_prune_ > 60 * 1000000LL) {
+        last_prune_ = now;
+        Buckets::iterator it = buckets_.begin();
+        while (it != buckets_.end()) {
+            double tokens = it->second.tokens +
+                            (now - it->second.time) * 1e-6 * options_.ip_rate;
+            if (tokens >= options_.ip_burst) {
+                buckets_.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+    Buckets::iterator it = buckets_.find(ip);
+    if (it == buckets_.end()) {
+        Bucket bucket;
+        bucket.tokens = options_.ip_burst;
+        bucket.time = now;
+        it = buckets_.insert(Buckets::value_type(ip, bucket)).first;
+    }
+    Bucket& bucket = it->second;
+    bucket.tokens += (now - bucket.time) * 1e-6 * options_.ip_rate;
+    if (bucket.tokens > options_.ip_burst) {
+        bucket.tokens = options_.ip_burst;
+    }
+    bucket.time = now;
+    if (bucket.tokens < 1) {
+        return false;
+    }
+    bucket.tokens -= 1;
+    return true;
+}
+
+bool luawt_Admission::enter(const std::string& ip) {
+    long long now = luawt_now();
+    boost::mutex::scoped_lock lock(mutex_);
+    if (options_.max_sessions &&
+            luawt_liveSessions() >= options_.max_sessions) {
+        return false;
+    }
+    // a waiting bootstrap would hold a thread of Wt, which is what
+    // the limit protects, so the client gets the busy page at once
+    if (options_.max_bootstraps &&
+            bootstraps_ >= options_.max_bootstraps) {
+        return false;
+    }
+    // taken last, so rejections by the global limits don't drain
+    // the bucket of the client
+    if (!takeToken(ip, now)) {
+        return false;
+    }
+    bootstraps_ += 1;
+    return true;
+}
+
+void luawt_Admission::leave() {
+    boost::mutex::scoped_lock lock(mutex_);
+    bootstraps_ -= 1;
+}
+
+/* Page shown instead of the application when the server is busy.
+   It has no Lua state and quits right after being rendered,
+   so it costs little more than a static response.
+*/
+class luawt_BusyApplication : public WApplication {
+public:
+    luawt_BusyApplication(const WEnvironment& env, int refresh):
+        WApplication(env) {
+        std::ostringstream seconds;
+        seconds << refresh;
+        addMetaHeader(MetaHttpHeader, "Refresh", seconds.str());
+        setTitle("Please wait");
+        if (root()) { // no root() in a widget set entry point
+            root()->addWidget(new WText(
+                "The server is busy. This page will reload "
+                "in a few seconds."
+            ));
+        }
+        quit();
+    }
+};
+
+WApplication* luawt_Admission::busyApplication(const WEnvironment& env) {
+    luawt_count(COUNTER_SESSIONS_REJECTED);
+    return new luawt_BusyApplication(env, options_.busy_refresh);
+}
@@ -0,0 +1,240 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include "boost-xtime.hpp"
+#include <Wt/WLogger>
+
+#include "globals.hpp"
+
+/* Slots run as coroutines. Field "coroutines" of the registry table
+   of the session maps threads of running slots to their state (and
+   keeps them from being collected until the session is destroyed).
+   A slot may yield only through luawt_suspend, which marks it as
+   waiting; the operation which suspended it resumes it with
+   luawt_resumeSlot or luawt_completeAsync. Rendering of the session
+   is deferred while a slot is waiting.
+   The memory limit of the session may refuse any allocation, so
+   the table is changed and threads are created with luawt_cpcall.
+*/
+
+enum {
+    SLOT_RUNNING = 1,
+    SLOT_WAITING = 2,
+};
+
+/* Pushes coroutines of the session, creating the table if needed. */
+static void luawt_pushCoroutines(lua_State* L) {
+    MyApplication::instance()->pushRegistry(L);
+    lua_getfield(L, -1, "coroutines");
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        lua_newtable(L);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, "coroutines");
+    }
+    lua_remove(L, -2); // registry of the session
+}
+
+struct luawt_SlotStateChange {
+    lua_State* co;
+    int state;
+};
+
+/* Runs with luawt_cpcall. */
+static int luawt_changeSlotState(lua_State* L) {
+    luawt_SlotStateChange* change =
+        reinterpret_cast<luawt_SlotStateChange*>(lua_touserdata(L, 1));
+    luawt_pushCoroutines(L);
+    lua_pushthread(change->co);
+    lua_xmove(change->co, L, 1);
+    if (change->state) {
+        lua_pushinteger(L, change->state);
+    } else {
+        lua_pushnil(L);
+    }
+    lua_rawset(L, -3);
+    return 0;
+}
+
+/* Sets state of coroutine co (0 removes it). Returns status,
+   error message is pushed to L on error.
+*/
+static int luawt_setSlotState(lua_State* L, lua_State* co, int state) {
+    luawt_SlotStateChange change = {co, state};
+    return luawt_cpcall(L, luawt_changeSlotState, &change);
+}
+
+static int luawt_slotState(lua_State* co) {
+    MyApplication* app = MyApplication::instance();
+    if (!luawt_isSessionState(app, co)) {
+        return 0; // not a thread of the session's state
+    }
+    app->pushRegistry(co);
+    lua_getfield(co, -1, "coroutines");
+    if (lua_isnil(co, -1)) {
+        lua_pop(co, 2);
+        return 0;
+    }
+    lua_pushthread(co);
+    lua_rawget(co, -2);
+    int state = lua_tointeger(co, -1);
+    lua_pop(co, 3);
+    return state;
+}
+
+bool luawt_canSuspend(lua_State* L) {
+    return luawt_slotState(L) == SLOT_RUNNING;
+}
+
+int luawt_suspend(lua_State* L) {
+    if (luawt_setSlotState(L, L, SLOT_WAITING) != LUA_OK) {
+        return WRAP_ERROR; // the message is at the top of L
+    }
+    return WRAP_SUSPEND;
+}
+
+/* Raises the error of a slot which yielded by itself.
+   Runs with luawt_cpcall, which leaves the message on the stack.
+*/
+static int luawt_yieldedOutside(lua_State* L) {
+    return luaL_error(L, "LuaWt: slot yielded outside of "
+                      "luawt asynchronous function");
+}
+
+/* Resumes co. Returns LUA_YIELD if it is waiting again, otherwise
+   it is finished: LUA_OK or error status with message pushed to L.
+*/
+static int luawt_runCoroutine(lua_State* L, lua_State* co, int nargs) {
+    int nres;
+    int status = my_resume(co, L, nargs, &nres);
+    if (status == LUA_YIELD) {
+        if (luawt_slotState(co) == SLOT_WAITING) {
+            MyApplication::instance()->deferRendering();
+            return status;
+        }
+        status = luawt_cpcall(L, luawt_yieldedOutside, 0);
+    } else if (status != LUA_OK) {
+        lua_xmove(co, L, 1); // error message
+    }
+    // the entry exists, so removing it allocates nothing
+    if (luawt_setSlotState(L, co, 0) != LUA_OK) {
+        lua_pop(L, 1);
+    }
+    return status;
+}
+
+struct luawt_SlotStart {
+    int func_id;
+    lua_State* co;
+};
+
+/* Creates the coroutine of a slot. Runs with luawt_cpcall. */
+static int luawt_newSlot(lua_State* L) {
+    luawt_SlotStart* start =
+        reinterpret_cast<luawt_SlotStart*>(lua_touserdata(L, 1));
+    lua_State* co = lua_newthread(L);
+    MyApplication::instance()->pushRegistry(co);
+    lua_rawgeti(co, -1, start->func_id);
+    lua_remove(co, -2); // registry of the session
+    luawt_pushCoroutines(L);
+    lua_pushvalue(L, -2); // thread
+    lua_pushinteger(L, SLOT_RUNNING);
+    lua_rawset(L, -3);
+    start->co = co; // kept by coroutines of the session
+    return 0;
+}
+
+int luawt_startSlot(lua_State* L, int func_id) {
+    luawt_SlotStart start = {func_id, 0};
+    int status = luawt_cpcall(L, luawt_newSlot, &start);
+    if (status != LUA_OK) {
+        return status;
+    }
+    return luawt_runCoroutine(L, start.co, 0);
+}
+
+/* Logs the error of a slot at the top of L and pops it. */
+static void luawt_slotFailed(lua_State* L) {
+    luawt_count(COUNTER_SLOT_ERRORS);
+    Wt::log("error") << "luawt: slot: " << lua_tostring(L, -1);
+    lua_pop(L, 1);
+}
+
+void luawt_resumeSlot(lua_State* co, int nargs) {
+    MyApplication* app = MyApplication::instance();
+    lua_State* L = app->L();
+    app->resumeRendering();
+    int status = luawt_setSlotState(L, co, SLOT_RUNNING);
+    if (status == LUA_OK) {
+        luawt_Watchdog watchdog(co, app->options());
+        status = luawt_runCoroutine(L, co, nargs);
+    } else if (luawt_setSlotState(L, co, 0) != LUA_OK) {
+        lua_pop(L, 1);
+    }
+    if (status != LUA_OK && status != LUA_YIELD) {
+        luawt_slotFailed(L);
+    }
+    app->triggerUpdate();
+}
+
+struct luawt_AsyncCall {
+    MyApplication* app;
+    int callback_ref;
+    lua_State* co;
+    const luawt_AsyncResult* result;
+    int nargs;
+};
+
+/* Calls the callback with the values of the result or moves them
+   to the coroutine. Runs with luawt_cpcall.
+*/
+static int luawt_callAsync(lua_State* L) {
+    luawt_AsyncCall* call =
+        reinterpret_cast<luawt_AsyncCall*>(lua_touserdata(L, 1));
+    lua_settop(L, 0);
+    if (call->co) {
+        call->nargs = call->result->push(L);
+        lua_xmove(L, call->co, call->nargs);
+        return 0;
+    }
+    call->app->pushUnref(L, call->callback_ref);
+    int nargs = call->result->push(L);
+    lua_call(L, nargs, 0);
+    return 0;
+}
+
+void luawt_completeAsync(
+    int callback_ref,
+    lua_State* co,
+    const luawt_AsyncResult& result,
+    const char* what
+) {
+    MyApplication* app = MyApplication::instance();
+    lua_State* L = app->L();
+    luawt_AsyncCall call = {app, callback_ref, co, &result, 0};
+    int status;
+    {
+        luawt_Watchdog watchdog(L, app->options());
+        status = luawt_cpcall(L, luawt_callAsync, &call);
+    }
+    if (co && status == LUA_OK) {
+        luawt_resumeSlot(co, call.nargs);
+        return;
+    }
+    if (co) {
+        // the slot can't get its results, it is finished
+        app->resumeRendering();
+        luawt_slotFailed(L);
+        if (luawt_setSlotState(L, co, 0) != LUA_OK) {
+            lua_pop(L, 1);
+        }
+    } else if (status != LUA_OK) {
+        Wt::log("error") << "luawt: callback of " << what << ": "
+                         << lua_tostring(L, -1);
+        lua_pop(L, 1);
+    }
+    app->triggerUpdate();
+}
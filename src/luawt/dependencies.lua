@@ -0,0 +1,78 @@
+-- Generated by tools/automate_bindings.py, read by tools/prune.lua
+-- Base class and classes of widgets returned by methods of
+-- each module (they need metatables).
+
+return {
+    MyApplication = {'WContainerWidget', 'WWidget'},
+    WAbstractItemView = {'WCompositeWidget'},
+    WAbstractMedia = {'WInteractWidget'},
+    WAbstractSpinBox = {'WLineEdit'},
+    WAbstractToggleButton = {'WFormWidget'},
+    WAnchor = {'WContainerWidget', 'WImage'},
+    WAudio = {'WAbstractMedia'},
+    WBreak = {'WWebWidget'},
+    WCalendar = {'WCompositeWidget'},
+    WCheckBox = {'WAbstractToggleButton'},
+    WComboBox = {'WFormWidget'},
+    WCompositeWidget = {'WWebWidget', 'WWidget'},
+    WContainerWidget = {'WInteractWidget', 'WWidget'},
+    WDateEdit = {'WCalendar', 'WLineEdit'},
+    WDatePicker = {'WCalendar', 'WCompositeWidget', 'WInteractWidget', 'WLineEdit'},
+    WDefaultLoadingIndicator = {'WText', 'WWidget'},
+    WDialog = {'WContainerWidget', 'WPopupWidget'},
+    WDoubleSpinBox = {'WAbstractSpinBox'},
+    WFileUpload = {'WProgressBar', 'WWebWidget'},
+    WFlashObject = {'WWebWidget'},
+    WFormWidget = {'WInteractWidget', 'WLabel'},
+    WGLWidget = {'WInteractWidget'},
+    WGoogleMap = {'WCompositeWidget'},
+    WGroupBox = {'WContainerWidget'},
+    WIconPair = {'WCompositeWidget', 'WImage'},
+    WImage = {'WInteractWidget'},
+    WInPlaceEdit = {'WCompositeWidget', 'WLineEdit', 'WPushButton', 'WText'},
+    WInteractWidget = {'WWebWidget'},
+    WLabel = {'WFormWidget', 'WImage', 'WInteractWidget'},
+    WLineEdit = {'WFormWidget'},
+    WMediaPlayer = {'WCompositeWidget', 'WInteractWidget', 'WProgressBar', 'WText', 'WWidget'},
+    WMenu = {'WCompositeWidget', 'WMenuItem', 'WStackedWidget'},
+    WMenuItem = {'WCheckBox', 'WContainerWidget', 'WMenu', 'WWidget'},
+    WMessageBox = {'WDialog', 'WPushButton', 'WText'},
+    WNavigationBar = {'WTemplate'},
+    WOverlayLoadingIndicator = {'WContainerWidget', 'WWidget'},
+    WPaintedWidget = {'WInteractWidget'},
+    WPanel = {'WCompositeWidget', 'WContainerWidget', 'WIconPair', 'WWidget'},
+    WPopupMenu = {'WMenu', 'WMenuItem'},
+    WPopupWidget = {'WCompositeWidget', 'WWidget'},
+    WProgressBar = {'WInteractWidget'},
+    WPushButton = {'WFormWidget', 'WPopupMenu'},
+    WRadioButton = {'WAbstractToggleButton'},
+    WScrollArea = {'WWebWidget', 'WWidget'},
+    WSelectionBox = {'WComboBox'},
+    WSlider = {'WFormWidget'},
+    WSpinBox = {'WAbstractSpinBox'},
+    WSplitButton = {'WCompositeWidget', 'WPopupMenu', 'WPushButton'},
+    WStackedWidget = {'WContainerWidget', 'WWidget'},
+    WSuggestionPopup = {'WPopupWidget'},
+    WTabWidget = {'WCompositeWidget', 'WMenuItem', 'WStackedWidget', 'WWidget'},
+    WTable = {'WInteractWidget', 'WTableCell'},
+    WTableCell = {'WContainerWidget', 'WTable'},
+    WTableView = {'WAbstractItemView'},
+    WTemplate = {'WInteractWidget', 'WWidget'},
+    WTemplateFormView = {'WTemplate'},
+    WText = {'WInteractWidget'},
+    WTextArea = {'WFormWidget'},
+    WTextEdit = {'WTextArea'},
+    WTimerWidget = {'WInteractWidget'},
+    WToolBar = {'WCompositeWidget', 'WWidget'},
+    WTree = {'WCompositeWidget', 'WTreeNode'},
+    WTreeNode = {'WCompositeWidget', 'WIconPair', 'WText', 'WTree', 'WTreeNode'},
+    WTreeTable = {'WCompositeWidget', 'WText', 'WTree', 'WTreeTableNode', 'WWidget'},
+    WTreeTableNode = {'WTreeNode', 'WTreeTable', 'WWidget'},
+    WTreeView = {'WAbstractItemView'},
+    WValidationStatus = {'WCompositeWidget'},
+    WVideo = {'WAbstractMedia'},
+    WViewWidget = {'WWebWidget'},
+    WVirtualImage = {'WCompositeWidget'},
+    WWebWidget = {'WWidget'},
+    WWidget = {'WWidget'},
+}
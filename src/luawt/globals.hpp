@@ -14,12 +14,16 @@
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <typeinfo>
+#include <vector>
 
 #include <boost/cast.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "boost-xtime.hpp"
+#include <boost/atomic.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 #include <Wt/WApplication>
 #include <Wt/WContainerWidget>
 #include <Wt/WDefaultLoadingIndicator>
@@ -33,6 +37,8 @@
 
 #include "Global.hpp"
 #include "enums.hpp"
+#include "metrics.hpp"
+#include "trace.hpp"
 
 #if LUA_VERSION_NUM == 501
 #define my_setfuncs(L, funcs) luaL_register(L, 0, funcs)
@@ -45,6 +51,20 @@
 #define my_rawlen lua_rawlen
 #endif
 
+#if LUA_VERSION_NUM >= 503
+#define my_dump(L, writer, data) lua_dump(L, writer, data, 0)
+#else
+#define my_dump lua_dump
+#endif
+
+#if LUA_VERSION_NUM >= 504
+#define my_resume lua_resume
+#elif LUA_VERSION_NUM >= 502
+#define my_resume(co, from, nargs, nres) lua_resume(co, from, nargs)
+#else
+#define my_resume(co, from, nargs, nres) lua_resume(co, nargs)
+#endif
+
 using namespace Wt;
 
 extern "C" {
@@ -58,34 +78,237 @@ int luaopen_luawt(lua_State* L);
 void* luawt_getShared(lua_State* L);
 void luawt_setShared(lua_State* L, void* sss);
 
+/* Options of Lua states of sessions, set by WServer. */
+struct luawt_AppOptions {
+    luawt_AppOptions():
+        track_memory(false), memory_limit(0),
+        gc_generational(false), gc_pause(0), gc_stepmul(0),
+        gc_defer_events(false), gc_idle_step(0),
+        hibernate_after_ms(0),
+        handler_instructions(0), handler_timeout_ms(0) {
+    }
+
+    /* Create states with the accounting allocator. */
+    bool track_memory;
+    /* Limit of the Lua heap of a session, bytes (0 is no limit). */
+    size_t memory_limit;
+    /* Generational mode of the collector (Lua 5.4). */
+    bool gc_generational;
+    /* Parameters of incremental mode, 0 keeps defaults of Lua. */
+    int gc_pause;
+    int gc_stepmul;
+    /* Stop the collector while a session handles an event. */
+    bool gc_defer_events;
+    /* Size of GC step (kilobytes) done after an event, 0 for none. */
+    int gc_idle_step;
+    /* Idle time after which a session hibernates, 0 for never. */
+    long long hibernate_after_ms;
+    /* Budget of one call of a handler (slot or code of the
+       application): Lua instructions and wall clock time.
+       0 is no limit.
+    */
+    long long handler_instructions;
+    long long handler_timeout_ms;
+};
+
+/* Applies GC options to a new state (see memory.cpp). */
+void luawt_configureGc(lua_State* L, const luawt_AppOptions& options);
+
+/* Stops the collector of L (if not 0) during its lifetime. */
+class luawt_GcPause {
+public:
+    luawt_GcPause(lua_State* L):
+        L_(L) {
+#if LUA_VERSION_NUM >= 502
+        if (L_ && !lua_gc(L_, LUA_GCISRUNNING, 0)) {
+            L_ = 0; // stopped by an outer pause
+        }
+#endif
+        if (L_) {
+            lua_gc(L_, LUA_GCSTOP, 0);
+        }
+    }
+
+    ~luawt_GcPause() {
+        if (L_) {
+            lua_gc(L_, LUA_GCRESTART, 0);
+        }
+    }
+
+private:
+    lua_State* L_;
+};
+
+/* Aborts Lua code run in L (and in coroutines created from L)
+   during its lifetime if it exceeds the budget of a handler
+   (see watchdog.cpp). A nested watchdog of the same thread only
+   installs the hook in its L: the outermost one limits the whole
+   handler.
+*/
+class luawt_Watchdog {
+public:
+    luawt_Watchdog(lua_State* L, const luawt_AppOptions& options);
+
+    ~luawt_Watchdog();
+
+    /* Called by the hook every interval_ instructions.
+       Returns true if the budget is exceeded.
+    */
+    bool exceeded();
+
+private:
+    bool active_; // false if nested or without a budget
+    int interval_;
+    long long instructions_left_;
+    long long deadline_;
+    bool counted_;
+
+    luawt_Watchdog(const luawt_Watchdog&);
+    void operator=(const luawt_Watchdog&);
+};
+
+/* Memory of a state created by luawt_newState, bytes. */
+struct luawt_MemoryUsage {
+    size_t used;
+    size_t peak;
+    size_t limit;
+};
+
+/* Creates a state whose allocations are counted in usage
+   (see memory.cpp). Returns 0 if memory is not enough.
+*/
+lua_State* luawt_newState(luawt_MemoryUsage* usage);
+
+/* Calls f with ud as light userdata argument in protected mode,
+   like lua_cpcall of Lua 5.1: nothing is allocated outside of it,
+   so a refused allocation raises an error instead of a panic.
+   Returns status of the call, error message is pushed on error.
+*/
+int luawt_cpcall(lua_State* L, lua_CFunction f, void* ud);
+
+/* Opens standard libraries and luawt in state L, whose argument 1
+   is luawt_getShared() to be used by the state.
+   Call it with luawt_cpcall.
+*/
+int luawt_openSessionLibs(lua_State* L);
+
+/* Makes a new table and stores its reference in the registry
+   to int* passed as argument 1. Call it with luawt_cpcall.
+*/
+int luawt_newTableRef(lua_State* L);
+
+/* Bytes used by a session state right after luawt_openSessionLibs,
+   measured once. session_memory_limit must leave room above it.
+*/
+size_t luawt_baselineMemory(void* shared);
+
+/* Lua state used by several sessions (option shared_states of
+   WServer). A session holds the mutex while it uses the state.
+   Each session has its own globals (see luawt_setSessionEnv) and
+   registry table; modules loaded by require are common.
+*/
+struct luawt_SharedState {
+    lua_State* L;
+    /* Memory of the whole state, without a limit. */
+    luawt_MemoryUsage memory;
+    boost::recursive_mutex mutex;
+    boost::atomic<int> sessions;
+};
+
+/* Locks the shared state of a session, if any. */
+class luawt_StateLock {
+public:
+    luawt_StateLock(luawt_SharedState* state):
+        state_(state) {
+        if (state_) {
+            state_->mutex.lock();
+        }
+    }
+
+    ~luawt_StateLock() {
+        if (state_) {
+            state_->mutex.unlock();
+        }
+    }
+
+private:
+    luawt_SharedState* state_;
+};
+
+struct SlotWrapper;
+
+/* Registration of sessions which are targets of luawt.post
+   (see sessions.cpp). Hibernated sessions are kept registered.
+*/
+void luawt_registerPostTarget(const std::string& id);
+void luawt_unregisterPostTarget(const std::string& id);
+bool luawt_isPostTarget(const std::string& id);
+std::vector<std::string> luawt_postTargets();
+
 class MyApplication : public WApplication {
 public:
     MyApplication(
         lua_State* L,
         void* shared,
-        const WEnvironment& env
+        const WEnvironment& env,
+        const luawt_AppOptions& options = luawt_AppOptions(),
+        luawt_SharedState* shared_state = 0
     )
         : WApplication(env)
         , L_(L)
         , owns_L_(false)
+        , shared_(shared)
+        , shared_state_(shared_state)
+        , options_(options)
+        , memory_()
+        , pending_async_(0)
+        , hibernated_(false)
+        , post_target_(false)
+        , slots_(0)
+        , gc_step_posted_(false)
+        , gc_step_done_(false)
+        , last_event_(luawt_now())
+        , previous_event_(last_event_)
     {
-        if (L == 0) {
+        if (shared_state) {
+            L_ = shared_state->L;
+            shared_state->sessions += 1;
+        } else if (L == 0) {
             owns_L_ = true;
-            L_ = luaL_newstate();
-            luaL_openlibs(L_);
-            luawt_setShared(L_, shared);
-#ifdef LUAWTEST
-            luaopen_luawtest(L_);
-#else
-            luaopen_luawt(L_);
-#endif
+            openState();
+        }
+        luawt_StateLock lock(shared_state_);
+        if (luawt_cpcall(L_, luawt_newTableRef, &registry_ref_) != LUA_OK) {
+            lua_pop(L_, 1); // error message
+            if (owns_L_) {
+                closeState();
+            } else if (shared_state_) {
+                shared_state_->sessions -= 1;
+            }
+            throw std::runtime_error("LuaWt: not enough memory "
+                                     "for session");
         }
+        luawt_count(COUNTER_SESSIONS_CREATED);
     }
 
     ~MyApplication() {
+        luawt_count(COUNTER_SESSIONS_DESTROYED);
+        if (hibernated_ && post_target_) {
+            luawt_unregisterPostTarget(sessionId());
+        }
         if (owns_L_) {
-            lua_close(L_);
+            if (L_) { // not hibernated
+                closeState();
+            }
+        } else {
+            // slots and globals of the session are in its registry
+            // table, so they are released together with it
+            luawt_StateLock lock(shared_state_);
+            luaL_unref(L_, LUA_REGISTRYINDEX, registry_ref_);
             L_ = 0;
+            if (shared_state_) {
+                shared_state_->sessions -= 1;
+            }
         }
     }
 
@@ -99,9 +322,178 @@ public:
         return L_;
     }
 
+    const luawt_AppOptions& options() const {
+        return options_;
+    }
+
+    /* Shared state of the session or 0 if it owns its state. */
+    luawt_SharedState* sharedState() const {
+        return shared_state_;
+    }
+
+    /* Pushes the registry table of the session. Values of
+       the session (slots, handlers) are kept there rather than in
+       the registry, which may be shared by other sessions.
+    */
+    void pushRegistry(lua_State* L) const {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, registry_ref_);
+    }
+
+    /* Head of the list of slots of the session (see SlotWrapper). */
+    SlotWrapper*& slots() {
+        return slots_;
+    }
+
+    /* Pops the value at the top of L into the registry table of
+       the session and returns its reference. Values of pending
+       operations (callbacks) are kept there, so they are released
+       with the session even if the operation never completes.
+    */
+    int ref(lua_State* L) const {
+        pushRegistry(L);
+        lua_insert(L, -2);
+        int result = luaL_ref(L, -2);
+        lua_pop(L, 1); // registry of the session
+        return result;
+    }
+
+    /* Pushes the value of a reference made by ref() and releases
+       the reference.
+    */
+    void pushUnref(lua_State* L, int reference) const {
+        pushRegistry(L);
+        lua_rawgeti(L, -1, reference);
+        luaL_unref(L, -2, reference);
+        lua_remove(L, -2); // registry of the session
+    }
+
+    void unref(lua_State* L, int reference) const {
+        pushRegistry(L);
+        luaL_unref(L, -1, reference);
+        lua_pop(L, 1); // registry of the session
+    }
+
+    /* Asynchronous operations (callbacks, suspended slots) keep
+       references into the state, so the session doesn't hibernate
+       while any of them is pending.
+    */
+    void beginAsync() {
+        pending_async_ += 1;
+    }
+
+    void endAsync() {
+        pending_async_ -= 1;
+    }
+
+    /* Hibernation of idle sessions (see hibernate.cpp).
+       bytecode is the code of the application, it is run again
+       when the session wakes up.
+    */
+    void enableHibernation(boost::shared_ptr<const std::string> bytecode);
+
+    void checkHibernation();
+
+    /* Runs the code of the application with the application and
+       its environment as arguments, in protected mode (see
+       memory.cpp). set_env, if given, is applied to the loaded
+       chunk. Returns status, error message is pushed on error.
+    */
+    int runCode(
+        const std::string& bytecode,
+        void (*set_env)(lua_State*, MyApplication*) = 0
+    );
+
+    /* Step of the collector after an event (option gc_idle_step).
+       Runs in an event posted by the previous one (see memory.cpp).
+    */
+    void gcStep();
+
+protected:
+    void notify(const WEvent& e) {
+        luawt_StateLock lock(shared_state_);
+        previous_event_ = last_event_;
+        last_event_ = luawt_now();
+        if (hibernated_) {
+            wake();
+        }
+        {
+            luawt_Timer timer(METRIC_EVENT);
+            luawt_TraceSpan span("request");
+            luawt_GcPause pause(options_.gc_defer_events ? L_ : 0);
+            WApplication::notify(e);
+        }
+        // collect garbage after the response has been sent rather
+        // than in the middle of the next event; the step runs in
+        // its own posted event, which doesn't post another one
+        if (options_.gc_idle_step && !gc_step_posted_ && !gc_step_done_) {
+            postGcStep();
+        }
+        gc_step_done_ = false;
+    }
+
 private:
     lua_State* L_;
     bool owns_L_;
+    void* shared_;
+    luawt_SharedState* shared_state_;
+    luawt_AppOptions options_;
+    int registry_ref_;
+    luawt_MemoryUsage memory_;
+    int pending_async_;
+    bool hibernated_;
+    /* The hibernated session was registered by luawt.handle. */
+    bool post_target_;
+    SlotWrapper* slots_;
+    bool gc_step_posted_;
+    /* gcStep() ran in the current event. */
+    bool gc_step_done_;
+    /* Times of the current and the previous event. */
+    long long last_event_;
+    long long previous_event_;
+    boost::shared_ptr<const std::string> bytecode_;
+    /* Result of onHibernate, serialized. */
+    std::string hibernated_state_;
+
+    void openState() {
+        if (options_.track_memory) {
+            memory_.used = 0;
+            memory_.peak = 0;
+            memory_.limit = options_.memory_limit;
+            L_ = luawt_newState(&memory_);
+            if (!L_) {
+                throw std::runtime_error("LuaWt: not enough memory "
+                                         "for Lua state of session");
+            }
+        } else {
+            L_ = luaL_newstate();
+        }
+        luawt_configureGc(L_, options_);
+        if (luawt_cpcall(L_, luawt_openSessionLibs, shared_) != LUA_OK) {
+            const char* message = lua_tostring(L_, -1);
+            std::string error = message ? message : "";
+            closeState();
+            throw std::runtime_error("LuaWt: unable to open Lua state "
+                                     "of session: " + error);
+        }
+    }
+
+    void closeState() {
+        lua_close(L_);
+        L_ = 0;
+        if (memory_.peak) {
+            luawt_record(METRIC_SESSION_MEMORY_PEAK, memory_.peak / 1024);
+        }
+    }
+
+    void scheduleHibernation(long long delay_ms);
+
+    void postGcStep();
+
+    bool slotsInRoot();
+
+    void hibernate();
+
+    void wake();
 };
 
 inline void checkPcallStatus(lua_State* L, int status) {
@@ -111,6 +503,47 @@ inline void checkPcallStatus(lua_State* L, int status) {
     }
 }
 
+/* Strings are passed between Lua and Wt with explicit length
+   (zero bytes are kept, no strlen) and as UTF-8, bypassing
+   the locale-dependent conversion of WString(const char*).
+*/
+inline std::string luawt_toStdString(lua_State* L, int index) {
+    size_t len;
+    const char* str = lua_tolstring(L, index, &len);
+    return str ? std::string(str, len) : std::string();
+}
+
+inline WString luawt_toWString(lua_State* L, int index) {
+    return WString::fromUTF8(luawt_toStdString(L, index));
+}
+
+inline void luawt_pushString(lua_State* L, const std::string& str) {
+    lua_pushlstring(L, str.data(), str.size());
+}
+
+inline int luawt_stringWriter(
+    lua_State* L,
+    const void* p,
+    size_t size,
+    void* ud
+) {
+    std::string* out = reinterpret_cast<std::string*>(ud);
+    out->append(reinterpret_cast<const char*>(p), size);
+    return 0;
+}
+
+/* Returns bytecode of the Lua function at the top of the stack.
+   The bytecode can be loaded into other Lua states with
+   luaL_loadbuffer. Upvalues are not saved.
+*/
+inline std::string luawt_dumpFunction(lua_State* L) {
+    std::string bytecode;
+    if (my_dump(L, luawt_stringWriter, &bytecode) != 0) {
+        throw std::logic_error("LuaWt: unable to dump Lua function");
+    }
+    return bytecode;
+}
+
 inline lua_State* getLuaState() {
     MyApplication* app = MyApplication::instance();
     return app ? app->L() : 0;
@@ -127,15 +560,49 @@ const char* luawt_typeToStr() {
     return name + 1;
 }
 
-/* All Wt classes have metatables. Metatables have 2
+/* All Wt classes have metatables. Metatables have 3
    fields:
    - __base -- base class metatable
    - __name -- name of class
+   - __index -- methods of the class, including inherited ones
 */
 
+/* Container of widgets created without parent. WidgetSet sessions
+   have no root(), so their widgets are kept in domRoot() until
+   they are bound to the page with bindWidget().
+*/
+/* Returns true if L is the state of the session of app or one of
+   its threads (slot coroutines): threads of a state share the
+   registry.
+*/
+inline bool luawt_isSessionState(MyApplication* app, lua_State* L) {
+    return app && app->L() && lua_topointer(app->L(), LUA_REGISTRYINDEX)
+        == lua_topointer(L, LUA_REGISTRYINDEX);
+}
+
+inline WContainerWidget* luawt_defaultParent(MyApplication* app) {
+    WContainerWidget* root = app->root();
+    return root ? root : app->domRoot();
+}
+
+inline WWidget* luawt_findById(MyApplication* app, const char* id) {
+    WWidget* widget = 0;
+    if (app->root()) {
+        widget = app->root()->findById(id);
+    }
+    if (!widget && app->domRoot()) {
+        widget = app->domRoot()->findById(id);
+    }
+    if (!widget && app->domRoot2()) {
+        // widgets bound with bindWidget()
+        widget = app->domRoot2()->findById(id);
+    }
+    return widget;
+}
+
 template<typename T>
 inline T* luawt_parseId(MyApplication* app, const char* id) {
-    WWidget* widget = app->root()->findById(id);
+    WWidget* widget = luawt_findById(app, id);
     return boost::polymorphic_downcast<T*>(widget);
 }
 
@@ -287,31 +754,179 @@ inline void luawt_toLua<MyApplication>(
     lua_setmetatable(L, -2);
 }
 
+/* Results of wrap<F>::call other than number of results.
+   lua_error and lua_yield may longjmp, so wrap<F>::func calls them
+   after all C++ objects of F and of call() are destroyed.
+*/
+enum {
+    WRAP_ERROR = -1,
+    WRAP_SUSPEND = -2,
+};
+
 template<lua_CFunction F>
 struct wrap {
     static int func(lua_State* L) {
+        int results = call(L);
+        if (results == WRAP_ERROR) {
+            return lua_error(L);
+        }
+        if (results == WRAP_SUSPEND) {
+            return lua_yield(L, 0);
+        }
+        return results;
+    }
+
+private:
+    static int call(lua_State* L) {
         try {
+            if (luawt_time_bindings || luawt_isTracing()) {
+                luawt_Timer timer(METRIC_BINDING, luawt_time_bindings);
+                luawt_TraceSpan span(
+                    "binding",
+                    reinterpret_cast<const void*>(F)
+                );
+                return F(L);
+            }
             return F(L);
         } catch (std::exception& e) {
             lua_pushstring(L, e.what());
         } catch (...) {
             lua_pushliteral(L, "Unknown exception");
         }
-        return lua_error(L);
+        return WRAP_ERROR;
+    }
+};
+
+/* Runs the function referenced by func_id in the registry table
+   of the session as a slot coroutine of the session's state L
+   (see coroutines.cpp). Returns LUA_OK, LUA_YIELD if the slot is
+   waiting for an asynchronous operation or an error status with
+   the message at the top of L.
+*/
+int luawt_startSlot(lua_State* L, int func_id);
+
+/* Returns true if L is a slot coroutine which can be suspended. */
+bool luawt_canSuspend(lua_State* L);
+
+/* Suspends slot coroutine L. Use as return luawt_suspend(L)
+   in a function called through wrap<F>, which yields after
+   the function has returned.
+   The operation must call luawt_resumeSlot when it completes.
+*/
+int luawt_suspend(lua_State* L);
+
+/* Resumes suspended slot coroutine with nargs values pushed to it
+   as results of the asynchronous function. Must be called within
+   the session.
+*/
+void luawt_resumeSlot(lua_State* co, int nargs);
+
+/* Appends value at index serialized to out (see serialize.cpp).
+   Returns false and sets error if the value can't be serialized.
+*/
+bool luawt_serialize(
+    lua_State* L,
+    int index,
+    std::string& out,
+    std::string& error
+);
+
+/* Returns value at index serialized. Throws std::logic_error
+   if the value can't be serialized.
+*/
+std::string luawt_checkSerialized(lua_State* L, int index);
+
+/* Pushes value serialized in data. Returns false and pushes
+   nothing if data is malformed.
+*/
+bool luawt_deserialize(lua_State* L, const char* data, size_t size);
+
+/* Values passed to a callback or to a suspended slot when an
+   asynchronous operation completes. push() runs in protected mode,
+   since the memory limit of the session may refuse any allocation,
+   so it must not own C++ objects. Returns the number of values.
+*/
+class luawt_AsyncResult {
+public:
+    virtual ~luawt_AsyncResult() {
+    }
+
+    virtual int push(lua_State* L) const = 0;
+};
+
+/* Pushes value, nil if ok (value is serialized), otherwise
+   nil, message.
+*/
+class luawt_SerializedResult : public luawt_AsyncResult {
+public:
+    luawt_SerializedResult(bool ok, const std::string& data):
+        ok_(ok), data_(data) {
+    }
+
+    int push(lua_State* L) const {
+        if (ok_) {
+            if (!luawt_deserialize(L, data_.c_str(), data_.size())) {
+                lua_pushnil(L);
+            }
+            lua_pushnil(L);
+        } else {
+            lua_pushnil(L);
+            lua_pushlstring(L, data_.c_str(), data_.size());
+        }
+        return 2;
     }
+
+private:
+    bool ok_;
+    const std::string& data_;
 };
 
+/* Passes result to the callback referenced by callback_ref (see
+   MyApplication::ref) or, if co is not 0, resumes suspended slot
+   coroutine co with it. what names the operation in the log.
+   Errors of the callback and refused allocations are logged.
+   Must be called within the session.
+*/
+void luawt_completeAsync(
+    int callback_ref,
+    lua_State* co,
+    const luawt_AsyncResult& result,
+    const char* what
+);
+
 struct SlotWrapper {
-    /* Slot func must be at the top of the stack. */
-    SlotWrapper():
-        app_(MyApplication::instance())
+    /* func_id is the reference of the slot function made by
+       MyApplication::ref(). It is made by the caller before any
+       C++ object, since it may raise an error of Lua.
+    */
+    SlotWrapper(MyApplication* app, int func_id,
+                const std::string& widget_id):
+        func_id_(func_id),
+        app_(app),
+        widget_id_(widget_id),
+        prev_slot_(0),
+        next_slot_(app_->slots())
     {
-        func_id_ = luaL_ref(app_->L(), LUA_REGISTRYINDEX);
+        if (next_slot_) {
+            next_slot_->prev_slot_ = this;
+        }
+        app_->slots() = this;
     }
 
     ~SlotWrapper() {
-        if (app_->L()) {
-            luaL_unref(app_->L(), LUA_REGISTRYINDEX, func_id_);
+        if (prev_slot_) {
+            prev_slot_->next_slot_ = next_slot_;
+        } else {
+            app_->slots() = next_slot_;
+        }
+        if (next_slot_) {
+            next_slot_->prev_slot_ = prev_slot_;
+        }
+        lua_State* L = app_->L();
+        if (L) {
+            app_->pushRegistry(L);
+            luaL_unref(L, -1, func_id_);
+            lua_pop(L, 1); // registry of the session
         }
     }
 
@@ -320,12 +935,20 @@ struct SlotWrapper {
        because lua_close() is triggered first in some cases.
     */
     MyApplication* app_;
+    /* ID of the widget which emits the signal (for tracing
+       and hibernation).
+    */
+    std::string widget_id_;
+    /* List of slots of the session, see MyApplication::slots(). */
+    SlotWrapper* prev_slot_;
+    SlotWrapper* next_slot_;
 };
 
 class SlotWrapperPtr {
 public:
-    SlotWrapperPtr():
-        slot_wrapper_(new SlotWrapper) {
+    SlotWrapperPtr(MyApplication* app, int func_id,
+                   const std::string& widget_id):
+        slot_wrapper_(new SlotWrapper(app, func_id, widget_id)) {
     }
 
     SlotWrapperPtr(const SlotWrapperPtr& other)
@@ -343,12 +966,24 @@ public:
                 "calling slot func."
             );
         }
-        lua_rawgeti(
-            L,
-            LUA_REGISTRYINDEX,
-            slot_wrapper_->func_id_
-        );
-        int status = lua_pcall(L, 0, 0, 0);
+        int status;
+        {
+            luawt_Timer timer(METRIC_SLOT);
+            luawt_TraceSpan span(
+                "slot",
+                0,
+                slot_wrapper_->widget_id_.c_str()
+            );
+            luawt_Watchdog watchdog(L, slot_wrapper_->app_->options());
+            status = luawt_startSlot(L, slot_wrapper_->func_id_);
+        }
+        luawt_record(METRIC_LUA_MEMORY, lua_gc(L, LUA_GCCOUNT, 0));
+        if (status == LUA_YIELD) {
+            return; // resumed by an asynchronous operation
+        }
+        if (status != LUA_OK) {
+            luawt_count(COUNTER_SLOT_ERRORS);
+        }
         checkPcallStatus(L, status);
     }
 
@@ -379,7 +1014,13 @@ private:
 #define CREATE_CONNECT_SIGNAL_FUNC(signal, widget_type) \
     int luawt_##widget_type##_connect_##signal(lua_State* L) { \
         GET_WIDGET(widget_type) \
-        SlotWrapperPtr slot_wrapper; \
+        MyApplication* app = MyApplication::instance(); \
+        if (!app) { \
+            throw std::logic_error("LuaWt: no WApplication when " \
+                                   "connecting slot"); \
+        } \
+        int func_id = app->ref(L); \
+        SlotWrapperPtr slot_wrapper(app, func_id, widget->id()); \
         widget->signal().connect(slot_wrapper); \
         return 0; \
     }
@@ -415,16 +1056,40 @@ public:
         if (mt) {
             my_setfuncs(L, mt);
         }
-        if (methods) {
+        if (methods || base) {
             lua_newtable(L);
-            my_setfuncs(L, methods);
+            if (methods) {
+                my_setfuncs(L, methods);
+            }
             lua_setfield(L, -2, "__index");
         }
         if (base) {
-            // mt(__index) = base_mt
-            // in order to enable base methods in current obj
+            // copy methods of base to current __index, so a method
+            // is found by one lookup; methods of current class
+            // override them
             lua_getfield(L, -1, "__index");
             luaL_getmetatable(L, base);
+            assert(lua_type(L, -1) == LUA_TTABLE);
+            lua_getfield(L, -1, "__index");
+            if (lua_type(L, -1) == LUA_TTABLE) {
+                lua_pushnil(L);
+                while (lua_next(L, -2) != 0) {
+                    lua_pushvalue(L, -2); // key
+                    lua_rawget(L, -6);
+                    bool overridden = !lua_isnil(L, -1);
+                    lua_pop(L, 1);
+                    if (overridden) {
+                        lua_pop(L, 1); // value
+                    } else {
+                        lua_pushvalue(L, -2); // key
+                        lua_insert(L, -2);
+                        lua_rawset(L, -6);
+                    }
+                }
+            }
+            lua_pop(L, 1); // base __index
+            // mt(__index) = base_mt
+            // for methods added to base after this declaration
             lua_setmetatable(L, -2);
             lua_pop(L, 1);
             // this_mt.__base = base_mt
@@ -765,6 +1430,11 @@ inline void luawt_returnEnum(
 /* These functions are called from luaopen() */
 void luawt_MyApplication(lua_State* L);
 void luawt_Shared(lua_State* L);
+void luawt_SharedMemory(lua_State* L);
+void luawt_Serialize(lua_State* L);
+void luawt_Memory(lua_State* L);
+void luawt_Hibernation(lua_State* L);
+void luawt_Trace(lua_State* L);
 void luawt_Test(lua_State* L);
 void luawt_WAbstractItemView(lua_State* L);
 void luawt_WAbstractMedia(lua_State* L);
@@ -825,6 +1495,11 @@ void luawt_WTemplate(lua_State* L);
 void luawt_WTestEnvironment(lua_State* L);
 #else
 void luawt_WServer(lua_State* L);
+void luawt_Main(lua_State* L);
+void luawt_Post(lua_State* L);
+void luawt_Http(lua_State* L);
+void luawt_Sleep(lua_State* L);
+void luawt_Jobs(lua_State* L);
 #endif
 void luawt_WTemplateFormView(lua_State* L);
 void luawt_WText(lua_State* L);
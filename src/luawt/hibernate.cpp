@@ -0,0 +1,241 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <string>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <Wt/WIOService>
+#include <Wt/WLogger>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+
+/* A session which had no events for hibernate_after seconds
+   releases its Lua state if the application registered
+   luawt.onHibernate. The value returned by it is serialized,
+   widgets of root() are removed and the state is closed.
+   The next event of the session opens a new state, runs the code
+   of the application again (rebuilding the widgets) and passes
+   the value to the function registered by luawt.onResume.
+   The waking event itself targets widgets which no longer exist,
+   so Wt drops it; the response renders the rebuilt widgets
+   and the user repeats the action on them.
+   Checks are posted to the session by WServer; they don't count
+   as events of the session.
+   A session hibernates only if all its slots are connected to
+   widgets of root(), which root()->clear() destroys: other slots
+   would refer to the closed state. A session registered by
+   luawt.handle stays registered, so luawt.post wakes it.
+   Sessions of widget set entry points have no root(), their
+   widgets are spread over the host page, so they never hibernate.
+*/
+
+static void luawt_runHibernationCheck() {
+    MyApplication* app = MyApplication::instance();
+    if (app) {
+        app->checkHibernation();
+    }
+}
+
+/* Runs on a thread of WIOService, outside of the session. */
+static void luawt_postHibernationCheck(const std::string& session_id) {
+    WServer* server = WServer::instance();
+    if (server) {
+        server->post(session_id, boost::bind(luawt_runHibernationCheck));
+    }
+}
+
+void MyApplication::enableHibernation(
+    boost::shared_ptr<const std::string> bytecode
+) {
+    bytecode_ = bytecode;
+    scheduleHibernation(options_.hibernate_after_ms);
+}
+
+void MyApplication::scheduleHibernation(long long delay_ms) {
+    WServer* server = WServer::instance();
+    if (server) {
+        server->ioService().schedule(
+            delay_ms,
+            boost::bind(luawt_postHibernationCheck, sessionId())
+        );
+    }
+}
+
+void MyApplication::checkHibernation() {
+    last_event_ = previous_event_;
+    if (hibernated_) {
+        return;
+    }
+    long long after_ms = options_.hibernate_after_ms;
+    long long idle_ms = (luawt_now() - last_event_) / 1000;
+    if (idle_ms < after_ms) {
+        scheduleHibernation(after_ms - idle_ms);
+        return;
+    }
+    if (pending_async_ == 0) {
+        hibernate();
+    }
+    if (!hibernated_) {
+        scheduleHibernation(after_ms);
+    }
+}
+
+bool MyApplication::slotsInRoot() {
+    for (SlotWrapper* slot = slots_; slot; slot = slot->next_slot_) {
+        if (!root()->findById(slot->widget_id_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MyApplication::hibernate() {
+    if (!owns_L_ || !slotsInRoot()) {
+        return;
+    }
+    lua_State* L = L_;
+    pushRegistry(L);
+    lua_getfield(L, -1, "on_hibernate");
+    lua_remove(L, -2); // registry of the session
+    if (lua_type(L, -1) != LUA_TFUNCTION) {
+        lua_pop(L, 1);
+        return;
+    }
+    std::string state, error;
+    bool ok;
+    {
+        luawt_Watchdog watchdog(L, options_);
+        ok = (lua_pcall(L, 0, 1, 0) == LUA_OK);
+    }
+    if (!ok) {
+        const char* e = lua_tostring(L, -1);
+        error = e ? e : "error in onHibernate";
+    } else {
+        ok = luawt_serialize(L, -1, state, error);
+    }
+    lua_pop(L, 1);
+    if (!ok) {
+        Wt::log("error") << "luawt: hibernation: " << error;
+        return;
+    }
+    pushRegistry(L);
+    lua_getfield(L, -1, "session_entry");
+    bool post_target = !lua_isnil(L, -1);
+    lua_pop(L, 2); // session_entry, registry of the session
+    root()->clear();
+    closeState();
+    if (post_target) {
+        // __gc of the entry has unregistered the session
+        luawt_registerPostTarget(sessionId());
+    }
+    post_target_ = post_target;
+    hibernated_state_.swap(state);
+    hibernated_ = true;
+    luawt_count(COUNTER_SESSIONS_HIBERNATED);
+}
+
+struct luawt_ResumeCall {
+    MyApplication* app;
+    const std::string* state;
+};
+
+/* Passes the state to the function registered by luawt.onResume,
+   if any. Runs with luawt_cpcall.
+*/
+static int luawt_callOnResume(lua_State* L) {
+    luawt_ResumeCall* call =
+        reinterpret_cast<luawt_ResumeCall*>(lua_touserdata(L, 1));
+    lua_settop(L, 0);
+    call->app->pushRegistry(L);
+    lua_getfield(L, 1, "on_resume");
+    if (lua_type(L, -1) != LUA_TFUNCTION) {
+        return 0;
+    }
+    if (!luawt_deserialize(L, call->state->c_str(), call->state->size())) {
+        lua_pushnil(L);
+    }
+    lua_call(L, 1, 0);
+    return 0;
+}
+
+void MyApplication::wake() {
+    hibernated_ = false;
+    post_target_ = false; // the code registers its handlers again
+    openState();
+    lua_State* L = L_;
+    if (luawt_cpcall(L, luawt_newTableRef, &registry_ref_) != LUA_OK) {
+        Wt::log("error") << "luawt: resuming of hibernated session: "
+                         << lua_tostring(L, -1);
+        closeState();
+        quit(); // the session has no registry table to run in
+        return;
+    }
+    int status = runCode(*bytecode_);
+    if (status == LUA_OK) {
+        luawt_ResumeCall call = {this, &hibernated_state_};
+        luawt_Watchdog watchdog(L, options_);
+        status = luawt_cpcall(L, luawt_callOnResume, &call);
+    }
+    if (status != LUA_OK) {
+        Wt::log("error") << "luawt: resuming of hibernated session: "
+                         << lua_tostring(L, -1);
+        lua_pop(L, 1);
+    }
+    hibernated_state_.clear();
+    if (updatesEnabled()) {
+        // a posted event (luawt.post) has no response of its own
+        triggerUpdate();
+    }
+    scheduleHibernation(options_.hibernate_after_ms);
+}
+
+static void luawt_setHibernationHandler(lua_State* L, const char* name) {
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+    MyApplication* app = MyApplication::instance();
+    if (!app) {
+        throw std::logic_error("LuaWt: hibernation handlers must be "
+                               "registered from a session");
+    }
+    app->pushRegistry(L);
+    lua_pushvalue(L, 1);
+    lua_setfield(L, -2, name);
+    lua_pop(L, 1); // registry of the session
+}
+
+/** Allows the session to hibernate when it is idle
+    Argument 1 is fn() returning the state of the session (see
+    luawt.serialize). The state is passed to the function
+    registered by luawt.onResume when the session wakes up.
+    Has effect if option hibernate_after of WServer is set.
+*/
+int luawt_Hibernation_onHibernate(lua_State* L) {
+    luawt_setHibernationHandler(L, "on_hibernate");
+    return 0;
+}
+
+/** Registers fn(state) called after a hibernated session wakes up
+    The code of the application is run again before the call,
+    so fn only restores the state on top of the new widgets.
+*/
+int luawt_Hibernation_onResume(lua_State* L) {
+    luawt_setHibernationHandler(L, "on_resume");
+    return 0;
+}
+
+static const luaL_Reg luawt_Hibernation_functions[] = {
+    METHOD(Hibernation, onHibernate),
+    METHOD(Hibernation, onResume),
+    {NULL, NULL},
+};
+
+void luawt_Hibernation(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    my_setfuncs(L, luawt_Hibernation_functions);
+    lua_pop(L, 1); // luawt
+}
@@ -0,0 +1,264 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <boost/system/error_code.hpp>
+#include <Wt/Http/Client>
+#include <Wt/Http/Message>
+#include <Wt/WLogger>
+#include <Wt/WObject>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+#include "server.hpp"
+
+/* Result of a request: table with status, body and headers
+   (lowercase name -> value), nil. Names are lowercased before,
+   since push() runs in protected mode.
+*/
+class luawt_HttpResponse : public luawt_AsyncResult {
+public:
+    luawt_HttpResponse(const Http::Message& response):
+        response_(response) {
+        const std::vector<Http::Message::Header>& headers =
+            response.headers();
+        for (size_t i = 0; i < headers.size(); i++) {
+            std::string name = headers[i].name();
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            names_.push_back(name);
+        }
+    }
+
+    int push(lua_State* L) const {
+        lua_newtable(L);
+        lua_pushinteger(L, response_.status());
+        lua_setfield(L, -2, "status");
+        const std::string& body = response_.body();
+        lua_pushlstring(L, body.c_str(), body.size());
+        lua_setfield(L, -2, "body");
+        lua_newtable(L);
+        const std::vector<Http::Message::Header>& headers =
+            response_.headers();
+        for (size_t i = 0; i < headers.size(); i++) {
+            lua_pushstring(L, headers[i].value().c_str());
+            lua_setfield(L, -2, names_[i].c_str());
+        }
+        lua_setfield(L, -2, "headers");
+        lua_pushnil(L);
+        return 2;
+    }
+
+private:
+    const Http::Message& response_;
+    std::vector<std::string> names_;
+};
+
+/* Outbound request of a session. The client is created within
+   the session, so Wt runs it on the server's WIOService and emits
+   done() inside the session. Rendering of the session is deferred
+   until then; no worker thread waits for the remote server.
+   The result goes either to a callback or to the slot coroutine
+   which was suspended by the request.
+*/
+class luawt_HttpCall : public WObject {
+public:
+    luawt_HttpCall(
+        MyApplication* app,
+        int callback_ref,
+        lua_State* co
+    ):
+        WObject(app), app_(app), callback_ref_(callback_ref), co_(co) {
+        client_ = new Http::Client(this);
+        client_->done().connect(this, &luawt_HttpCall::handleDone);
+        app_->beginAsync();
+    }
+
+    Http::Client* client() {
+        return client_;
+    }
+
+    /* Call after the request was started. */
+    void started() {
+        if (!co_) {
+            // slot coroutines defer rendering themselves
+            app_->deferRendering();
+        }
+    }
+
+private:
+    MyApplication* app_;
+    Http::Client* client_;
+    int callback_ref_;
+    lua_State* co_;
+
+    static void destroy(luawt_HttpCall* call) {
+        delete call;
+    }
+
+    void handleDone(
+        boost::system::error_code err,
+        const Http::Message& response
+    ) {
+        app_->endAsync();
+        if (!co_) {
+            app_->resumeRendering();
+        }
+        if (err) {
+            std::string message = err.message();
+            luawt_SerializedResult result(false, message);
+            luawt_completeAsync(callback_ref_, co_, result, "luawt.http");
+        } else {
+            luawt_HttpResponse result(response);
+            luawt_completeAsync(callback_ref_, co_, result, "luawt.http");
+        }
+        // done() of the client is being emitted, so the call is
+        // deleted later (or with the application)
+        WServer::instance()->post(
+            app_->sessionId(),
+            boost::bind(&luawt_HttpCall::destroy, this)
+        );
+    }
+};
+
+/* Arguments: url, [body,] [callback,] [options].
+   Without callback, suspends the slot coroutine and returns
+   response, error to it.
+*/
+static int luawt_httpRequest(lua_State* L, bool has_body) {
+    MyApplication* app = MyApplication::instance();
+    // L is the state of the session or its slot coroutine
+    if (!luawt_isSessionState(app, L)) {
+        throw std::logic_error("LuaWt: luawt.http must be called "
+                               "from a session");
+    }
+    // check all arguments before C++ objects are made:
+    // errors of luaL_check* would skip their destructors
+    const char* url = luaL_checkstring(L, 1);
+    int callback_index = has_body ? 3 : 2;
+    int options_index = callback_index + 1;
+    size_t body_len = 0;
+    const char* body = 0;
+    if (has_body) {
+        body = luaL_checklstring(L, 2, &body_len);
+    }
+    lua_State* co = 0;
+    if (lua_type(L, callback_index) != LUA_TFUNCTION) {
+        if (!luawt_canSuspend(L)) {
+            throw std::logic_error("LuaWt: luawt.http needs a callback "
+                                   "outside of slots");
+        }
+        co = L;
+        options_index = callback_index;
+    }
+    int timeout = 10;
+    std::size_t max_size = 1024 * 1024;
+    int headers_index = 0;
+    if (!lua_isnoneornil(L, options_index)) {
+        luaL_checktype(L, options_index, LUA_TTABLE);
+        lua_getfield(L, options_index, "timeout");
+        if (!lua_isnil(L, -1)) {
+            timeout = luaL_checkinteger(L, -1);
+        }
+        lua_pop(L, 1);
+        lua_getfield(L, options_index, "max_size");
+        if (!lua_isnil(L, -1)) {
+            max_size = luaL_checkinteger(L, -1);
+        }
+        lua_pop(L, 1);
+        lua_getfield(L, options_index, "headers");
+        if (lua_isnil(L, -1)) {
+            lua_pop(L, 1);
+        } else {
+            luaL_checktype(L, -1, LUA_TTABLE);
+            headers_index = lua_gettop(L);
+            lua_pushnil(L);
+            while (lua_next(L, headers_index) != 0) {
+                if (lua_type(L, -2) != LUA_TSTRING ||
+                        !lua_isstring(L, -1)) {
+                    throw std::logic_error("LuaWt: names and values "
+                                           "of headers must be strings");
+                }
+                lua_pop(L, 1); // value
+            }
+        }
+    }
+    Http::Message message;
+    if (has_body) {
+        message.addBodyText(std::string(body, body_len));
+    }
+    if (headers_index) {
+        lua_pushnil(L);
+        while (lua_next(L, headers_index) != 0) {
+            message.addHeader(lua_tostring(L, -2), lua_tostring(L, -1));
+            lua_pop(L, 1); // value
+        }
+        lua_pop(L, 1); // headers
+    }
+    int callback_ref = LUA_NOREF;
+    if (!co) {
+        lua_pushvalue(L, callback_index);
+        callback_ref = app->ref(L);
+    }
+    luawt_HttpCall* call = new luawt_HttpCall(app, callback_ref, co);
+    call->client()->setTimeout(timeout);
+    call->client()->setMaximumResponseSize(max_size);
+    bool ok = has_body ?
+              call->client()->post(url, message) :
+              call->client()->get(url, message.headers());
+    if (!ok) {
+        app->unref(L, callback_ref);
+        app->endAsync();
+        delete call;
+        throw std::logic_error(std::string("LuaWt: unable to request ") +
+                               url);
+    }
+    call->started();
+    if (co) {
+        return luawt_suspend(L);
+    }
+    return 0;
+}
+
+/** Sends GET request without blocking the worker thread
+    Arguments: url, callback, options (optional table: timeout in
+    seconds, max_size of response in bytes, headers).
+    Must be called from a session. callback(response, error) is
+    called in the session; response has status, body and headers.
+    Rendering of the session waits for the callback.
+    Inside of a slot the callback can be omitted: then the slot
+    is suspended and the call returns response, error.
+*/
+int luawt_http_get(lua_State* L) {
+    return luawt_httpRequest(L, false);
+}
+
+/** Sends POST request without blocking the worker thread
+    Arguments: url, body, callback, options (see get).
+*/
+int luawt_http_post(lua_State* L) {
+    return luawt_httpRequest(L, true);
+}
+
+static const luaL_Reg luawt_http_functions[] = {
+    METHOD(http, get),
+    METHOD(http, post),
+    {NULL, NULL},
+};
+
+void luawt_Http(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    lua_newtable(L); // http table
+    my_setfuncs(L, luawt_http_functions);
+    lua_setfield(L, -2, "http");
+    lua_pop(L, 1); // luawt
+}
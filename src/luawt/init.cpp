@@ -18,13 +18,27 @@ static const luawt_Reg luawt_modules[] = {
     // Base must be before child
     MODULE(MyApplication),
     MODULE(Shared),
+    MODULE(SharedMemory),
+    MODULE(Serialize),
+    MODULE(Memory),
+    MODULE(Hibernation),
     MODULE(Test),
+    MODULE(Trace),
     MODULE(WEnvironment),
 #ifdef LUAWTEST
     MODULE(WTestEnvironment),
 #else
     MODULE(WServer),
+    MODULE(Main),
+    MODULE(Post),
+    MODULE(Http),
+    MODULE(Sleep),
+    MODULE(Jobs),
 #endif
+#ifdef LUAWT_PRUNED
+    // subset of widgets selected by tools/prune.lua
+#include "pruned_modules.hpp"
+#else
     MODULE(WWidget),
     MODULE(WCompositeWidget),
     MODULE(WPopupWidget),
@@ -96,6 +110,7 @@ static const luawt_Reg luawt_modules[] = {
     MODULE(WStackedWidget),
     MODULE(WGroupBox),
     MODULE(WPushButton),
+#endif
     {NULL, NULL},
 };
 #undef MODULE
@@ -0,0 +1,291 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <Wt/WLogger>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+#include "server.hpp"
+
+struct luawt_Job {
+    std::string module;
+    std::string function;
+    std::string args;
+    std::string session_id;
+    /* Reference to callback in the session's state or LUA_NOREF. */
+    int callback_ref;
+    /* Suspended slot coroutine, if there is no callback. */
+    lua_State* co;
+};
+
+/* Threads with their own Lua states taking jobs from one queue.
+   Each worker keeps its state (with loaded modules) between jobs.
+   The queue is a single deque under one mutex, not per-worker
+   deques with stealing: jobs come from session threads, not from
+   the workers, so there is no local queue to push to, and the lock
+   is held only to push or pop a job while the job itself runs
+   Lua code outside of it. One queue also keeps jobs in FIFO order.
+   If profiling shows contention on mutex_, split the queue then.
+*/
+class luawt_JobPool {
+public:
+    luawt_JobPool(void* shared, int threads):
+        shared_(shared), stopping_(false) {
+        for (int i = 0; i < threads; i++) {
+            threads_.create_thread(boost::bind(&luawt_JobPool::work, this));
+        }
+    }
+
+    void submit(const luawt_Job& job) {
+        boost::mutex::scoped_lock lock(mutex_);
+        jobs_.push_back(job);
+        cond_.notify_one();
+    }
+
+    size_t size() const {
+        return threads_.size();
+    }
+
+    /* Waits for running jobs; queued jobs are dropped. */
+    void stop() {
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            stopping_ = true;
+            jobs_.clear();
+            cond_.notify_all();
+        }
+        threads_.join_all();
+    }
+
+private:
+    void* shared_;
+    boost::thread_group threads_;
+    boost::mutex mutex_;
+    boost::condition_variable cond_;
+    std::deque<luawt_Job> jobs_;
+    bool stopping_;
+
+    void work() {
+        lua_State* L = luaL_newstate();
+        luaL_openlibs(L);
+        luawt_setShared(L, shared_);
+        while (true) {
+            luawt_Job job;
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                while (jobs_.empty() && !stopping_) {
+                    cond_.wait(lock);
+                }
+                if (stopping_) {
+                    break;
+                }
+                job = jobs_.front();
+                jobs_.pop_front();
+            }
+            std::string result;
+            bool ok = run(L, job, result);
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                if (stopping_) {
+                    break; // sessions are being destroyed
+                }
+            }
+            deliver(job, ok, result);
+        }
+        lua_close(L);
+    }
+
+    /* Calls require(module)[function](args). */
+    static bool run(lua_State* L, const luawt_Job& job, std::string& result) {
+        int top = lua_gettop(L);
+        lua_getglobal(L, "require");
+        lua_pushstring(L, job.module.c_str());
+        int status = lua_pcall(L, 1, 1, 0);
+        if (status == LUA_OK) {
+            lua_getfield(L, -1, job.function.c_str());
+            if (lua_type(L, -1) != LUA_TFUNCTION) {
+                lua_settop(L, top);
+                result = "no function '" + job.function +
+                         "' in module '" + job.module + "'";
+                return false;
+            }
+            if (!luawt_deserialize(L, job.args.c_str(), job.args.size())) {
+                lua_pushnil(L);
+            }
+            status = lua_pcall(L, 1, 1, 0);
+        }
+        bool ok = (status == LUA_OK);
+        if (ok) {
+            std::string error;
+            if (!luawt_serialize(L, -1, result, error)) {
+                result = error;
+                ok = false;
+            }
+        } else {
+            size_t len;
+            const char* str = lua_tolstring(L, -1, &len);
+            if (str) {
+                result.assign(str, len);
+            } else {
+                result = "error in job";
+            }
+        }
+        lua_settop(L, top);
+        return ok;
+    }
+
+    static void deliver(const luawt_Job& job, bool ok, const std::string& result) {
+        if (job.callback_ref == LUA_NOREF && !job.co) {
+            return;
+        }
+        WServer* server = WServer::instance();
+        if (server) {
+            server->post(
+                job.session_id,
+                boost::bind(luawt_JobPool::complete, job, ok, result)
+            );
+        }
+    }
+
+    /* Runs in the session which submitted the job. */
+    static void complete(
+        const luawt_Job& job,
+        bool ok,
+        const std::string& result
+    ) {
+        MyApplication* app = MyApplication::instance();
+        if (!app) {
+            return;
+        }
+        app->endAsync();
+        luawt_completeAsync(
+            job.callback_ref,
+            job.co,
+            luawt_SerializedResult(ok, result),
+            "luawt.jobs"
+        );
+    }
+};
+
+/* Created by the first job or luawt.jobs.start, destroyed
+   by luawt_stopJobs when a server stops.
+*/
+static luawt_JobPool* luawt_job_pool = 0;
+static boost::mutex luawt_job_pool_mutex;
+
+static luawt_JobPool* luawt_getJobPool(lua_State* L, int threads) {
+    boost::mutex::scoped_lock lock(luawt_job_pool_mutex);
+    if (!luawt_job_pool) {
+        if (threads <= 0) {
+            threads = boost::thread::hardware_concurrency();
+        }
+        if (threads <= 0) {
+            threads = 2;
+        }
+        luawt_job_pool = new luawt_JobPool(luawt_getShared(L), threads);
+    }
+    return luawt_job_pool;
+}
+
+void luawt_stopJobs() {
+    luawt_JobPool* pool;
+    {
+        boost::mutex::scoped_lock lock(luawt_job_pool_mutex);
+        pool = luawt_job_pool;
+        luawt_job_pool = 0;
+    }
+    if (pool) {
+        pool->stop();
+        delete pool;
+    }
+}
+
+/** Starts the pool of job threads
+    Argument 1 is the number of threads (default: number of cores).
+    Raises an error if the pool is running (it is started by
+    the first job too). Returns the number of threads.
+*/
+int luawt_jobs_start(lua_State* L) {
+    int threads = luaL_optinteger(L, 1, 0);
+    {
+        boost::mutex::scoped_lock lock(luawt_job_pool_mutex);
+        if (luawt_job_pool) {
+            throw std::logic_error("LuaWt: the pool of jobs "
+                                   "is already running");
+        }
+    }
+    lua_pushinteger(L, luawt_getJobPool(L, threads)->size());
+    return 1;
+}
+
+/** Runs require(module)[fn](args) on a job thread
+    Arguments: module, fn, args, callback (optional).
+    Must be called from a session. The job runs in a Lua state of
+    the pool (with its own globals), so args and the result are
+    copied between the states (see luawt.serialize).
+    callback(result, error) is called in the session. Inside of
+    a slot the callback can be omitted: then the slot is suspended
+    and the call returns result, error.
+*/
+int luawt_jobs_submit(lua_State* L) {
+    // check arguments before job is constructed: luaL_check*
+    // longjmps past C++ objects
+    const char* module = luaL_checkstring(L, 1);
+    const char* function = luaL_checkstring(L, 2);
+    luawt_Job job;
+    job.module = module;
+    job.function = function;
+    job.args = luawt_checkSerialized(L, 3);
+    MyApplication* app = MyApplication::instance();
+    if (!app) {
+        throw std::logic_error("LuaWt: luawt.jobs.submit must be "
+                               "called from a session");
+    }
+    job.session_id = app->sessionId();
+    job.callback_ref = LUA_NOREF;
+    job.co = 0;
+    if (lua_type(L, 4) == LUA_TFUNCTION) {
+        lua_pushvalue(L, 4);
+        job.callback_ref = app->ref(L);
+        if (!app->updatesEnabled()) {
+            app->enableUpdates(true);
+        }
+    } else if (luawt_canSuspend(L)) {
+        job.co = L;
+    }
+    if (job.callback_ref != LUA_NOREF || job.co) {
+        app->beginAsync();
+    }
+    luawt_getJobPool(L, 0)->submit(job);
+    if (job.co) {
+        return luawt_suspend(L);
+    }
+    return 0;
+}
+
+static const luaL_Reg luawt_jobs_functions[] = {
+    METHOD(jobs, start),
+    METHOD(jobs, submit),
+    {NULL, NULL},
+};
+
+void luawt_Jobs(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    lua_newtable(L); // jobs table
+    my_setfuncs(L, luawt_jobs_functions);
+    lua_setfield(L, -2, "jobs");
+    lua_pop(L, 1); // luawt
+}
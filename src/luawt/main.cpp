@@ -0,0 +1,328 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <cerrno>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <time.h>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <Wt/WLogger>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+#include "server.hpp"
+
+/* Session which waits for the result of a task. */
+struct luawt_Waiter {
+    std::string session_id;
+    /* Reference to the callback in the state of the session
+       or LUA_NOREF.
+    */
+    int callback_ref;
+};
+
+typedef std::vector<luawt_Waiter> Waiters;
+
+/* Tasks posted by sessions to the main state. A task is identified
+   by its name and arguments: posting a task which is already queued
+   or running adds a waiter instead of a new task.
+*/
+class luawt_MainQueue {
+public:
+    luawt_MainQueue():
+        quit_(false) {
+    }
+
+    void post(const std::string& key, const luawt_Waiter& waiter) {
+        boost::mutex::scoped_lock lock(mutex_);
+        std::map<std::string, Waiters>::iterator it = in_flight_.find(key);
+        if (it != in_flight_.end()) {
+            it->second.push_back(waiter);
+            return;
+        }
+        in_flight_[key].push_back(waiter);
+        keys_.push_back(key);
+        cond_.notify_one();
+    }
+
+    /* Returns false on timeout or quit. */
+    bool wait(std::string& key, int timeout_ms) {
+        boost::mutex::scoped_lock lock(mutex_);
+        if (keys_.empty() && !quit_) {
+            cond_.timed_wait(
+                lock,
+                boost::posix_time::milliseconds(timeout_ms)
+            );
+        }
+        if (keys_.empty() || quit_) {
+            return false;
+        }
+        key = keys_.front();
+        keys_.pop_front();
+        return true;
+    }
+
+    /* Removes the task and returns sessions waiting for it. */
+    Waiters finish(const std::string& key) {
+        boost::mutex::scoped_lock lock(mutex_);
+        Waiters waiters;
+        std::map<std::string, Waiters>::iterator it = in_flight_.find(key);
+        if (it != in_flight_.end()) {
+            waiters.swap(it->second);
+            in_flight_.erase(it);
+        }
+        return waiters;
+    }
+
+    void setQuit(bool quit) {
+        boost::mutex::scoped_lock lock(mutex_);
+        quit_ = quit;
+        cond_.notify_one();
+    }
+
+    bool quit() {
+        boost::mutex::scoped_lock lock(mutex_);
+        return quit_;
+    }
+
+private:
+    boost::mutex mutex_;
+    boost::condition_variable cond_;
+    std::deque<std::string> keys_;
+    std::map<std::string, Waiters> in_flight_;
+    bool quit_;
+};
+
+static luawt_MainQueue luawt_main_queue;
+
+static std::string luawt_taskKey(
+    const std::string& name,
+    const std::string& args
+) {
+    return name + '\0' + args;
+}
+
+static void luawt_splitTaskKey(
+    const std::string& key,
+    std::string& name,
+    std::string& args
+) {
+    size_t zero = key.find('\0');
+    name = key.substr(0, zero);
+    args = key.substr(zero + 1);
+}
+
+/* Runs in the session which posted the task. */
+static void luawt_deliverResult(
+    int callback_ref,
+    bool ok,
+    const std::string& result
+) {
+    MyApplication* app = MyApplication::instance();
+    if (!app) {
+        return;
+    }
+    app->endAsync();
+    luawt_completeAsync(
+        callback_ref,
+        0,
+        luawt_SerializedResult(ok, result),
+        "luawt.main.post"
+    );
+}
+
+/* Calls handler name(args) in the main state. Returns its result
+   serialized or error message.
+*/
+static bool luawt_runTask(
+    lua_State* L,
+    const std::string& name,
+    const std::string& args,
+    std::string& result
+) {
+    lua_getfield(L, LUA_REGISTRYINDEX, "luawt_main_handlers");
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        result = "no handlers in the main state";
+        return false;
+    }
+    lua_getfield(L, -1, name.c_str());
+    lua_remove(L, -2); // handlers
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        result = "no handler for task '" + name + "'";
+        return false;
+    }
+    if (!luawt_deserialize(L, args.c_str(), args.size())) {
+        lua_pushnil(L);
+    }
+    int status = lua_pcall(L, 1, 1, 0);
+    bool ok = (status == LUA_OK);
+    if (ok) {
+        result.clear();
+        std::string error;
+        if (!luawt_serialize(L, -1, result, error)) {
+            result = error;
+            ok = false;
+        }
+    } else {
+        size_t len;
+        const char* str = lua_tolstring(L, -1, &len);
+        if (str) {
+            result.assign(str, len);
+        } else {
+            result = "error in handler of task '" + name + "'";
+        }
+    }
+    lua_pop(L, 1);
+    return ok;
+}
+
+/* Checks signals blocked by luawt_runMain without waiting. */
+static int luawt_pendingSignal(const sigset_t& signals) {
+    struct timespec zero = {0, 0};
+    siginfo_t info;
+    int sig = sigtimedwait(&signals, &info, &zero);
+    return sig > 0 ? sig : 0;
+}
+
+int luawt_runMain(lua_State* L, WServer& server) {
+    sigset_t signals, old_signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGQUIT);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, &old_signals);
+    luawt_main_queue.setQuit(false);
+    int sig = 0;
+    while (!luawt_main_queue.quit()) {
+        sig = luawt_pendingSignal(signals);
+        if (sig) {
+            break;
+        }
+        std::string key;
+        if (!luawt_main_queue.wait(key, 100)) {
+            continue;
+        }
+        std::string name, args, result;
+        luawt_splitTaskKey(key, name, args);
+        bool ok = luawt_runTask(L, name, args, result);
+        if (!ok) {
+            Wt::log("error") << "luawt: task of luawt.main: " << result;
+        }
+        Waiters waiters = luawt_main_queue.finish(key);
+        for (size_t i = 0; i < waiters.size(); i++) {
+            if (waiters[i].callback_ref == LUA_NOREF) {
+                continue;
+            }
+            server.post(
+                waiters[i].session_id,
+                boost::bind(
+                    luawt_deliverResult,
+                    waiters[i].callback_ref,
+                    ok,
+                    result
+                )
+            );
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &old_signals, 0);
+    return sig;
+}
+
+void luawt_quitMain() {
+    luawt_main_queue.setQuit(true);
+}
+
+/** Registers handler of tasks in the main state
+    Argument 1 is the name of task, argument 2 is the function.
+    The function is called as fn(args) by server:run() and returns
+    a value which is passed to the sessions (see luawt.serialize).
+*/
+int luawt_main_handle(lua_State* L) {
+    luaL_checkstring(L, 1);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    lua_getfield(L, LUA_REGISTRYINDEX, "luawt_main_handlers");
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        lua_newtable(L);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, LUA_REGISTRYINDEX, "luawt_main_handlers");
+    }
+    lua_pushvalue(L, 1);
+    lua_pushvalue(L, 2);
+    lua_rawset(L, -3);
+    lua_pop(L, 1); // handlers
+    return 0;
+}
+
+/** Runs a task in the main state from a session
+    Argument 1 is the name of the task, argument 2 is its argument
+    (see luawt.serialize), argument 3 is optional callback(result,
+    error) called in this session (with updates triggered) when
+    the task is done.
+    Identical tasks (same name and argument) which are queued
+    or running are run once and the result goes to all of them.
+*/
+int luawt_main_post(lua_State* L) {
+    size_t name_len;
+    const char* name = luaL_checklstring(L, 1, &name_len);
+    bool has_callback = !lua_isnoneornil(L, 3);
+    if (has_callback) {
+        // before C++ objects: luaL_check* errors skip destructors
+        luaL_checktype(L, 3, LUA_TFUNCTION);
+    }
+    if (strlen(name) != name_len) {
+        throw std::logic_error("LuaWt: name of task must not contain "
+                               "zero bytes");
+    }
+    MyApplication* app = MyApplication::instance();
+    if (!app) {
+        throw std::logic_error("LuaWt: luawt.main.post must be called "
+                               "from a session");
+    }
+    std::string args = luawt_checkSerialized(L, 2);
+    luawt_Waiter waiter;
+    waiter.session_id = app->sessionId();
+    waiter.callback_ref = LUA_NOREF;
+    if (has_callback) {
+        lua_pushvalue(L, 3);
+        waiter.callback_ref = app->ref(L);
+        app->beginAsync();
+        if (!app->updatesEnabled()) {
+            app->enableUpdates(true);
+        }
+    }
+    luawt_main_queue.post(
+        luawt_taskKey(std::string(name, name_len), args),
+        waiter
+    );
+    return 0;
+}
+
+static const luaL_Reg luawt_main_functions[] = {
+    METHOD(main, handle),
+    METHOD(main, post),
+    {NULL, NULL},
+};
+
+void luawt_Main(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    lua_newtable(L); // main table
+    my_setfuncs(L, luawt_main_functions);
+    lua_setfield(L, -2, "main");
+    lua_pop(L, 1); // luawt
+}
@@ -0,0 +1,704 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#ifndef MARSHAL_HPP_
+#define MARSHAL_HPP_
+
+#include <string>
+
+#include "boost-xtime.hpp"
+#include <Wt/WLength>
+#include <Wt/WLink>
+#include <Wt/WString>
+
+#include "globals.hpp"
+
+/* Bindings of methods derived from C++ member function pointers.
+   BIND_METHOD(Klass, method) defines luawt_Klass_method, which
+   replaces a generated lua_CFunction when the method has one
+   signature, and is put to the table of methods with METHOD():
+   types of arguments are checked like by luawt_checkArgsGroup and
+   conversions are done by luawt_Arg and luawt_Result. The signature
+   is checked by the compiler when the template is instantiated.
+   Methods with overloads, default arguments or enums are still
+   generated by tools/automate_bindings.py as full functions.
+*/
+
+/* Conversion of an argument of type T from Lua.
+   type() is its name for luawt_checkArgsGroup, get() reads it.
+   The generic case is a widget passed by reference.
+*/
+template<typename T>
+struct luawt_Arg {
+    static const char* type() {
+        return luawt_typeToStr<T>();
+    }
+
+    static T& get(lua_State* L, int index) {
+        return *luawt_checkFromLua<T>(L, index);
+    }
+};
+
+template<typename T>
+struct luawt_Arg<T*> {
+    static const char* type() {
+        return luawt_typeToStr<T>();
+    }
+
+    static T* get(lua_State* L, int index) {
+        return luawt_checkFromLua<T>(L, index);
+    }
+};
+
+template<typename T>
+struct luawt_Arg<const T*>: luawt_Arg<T*> {
+};
+
+template<typename T>
+struct luawt_Arg<T&>: luawt_Arg<T> {
+};
+
+template<typename T>
+struct luawt_Arg<const T&>: luawt_Arg<T> {
+};
+
+template<typename T>
+struct luawt_Arg<const T>: luawt_Arg<T> {
+};
+
+template<>
+struct luawt_Arg<bool> {
+    static const char* type() {
+        return "bool";
+    }
+
+    static bool get(lua_State* L, int index) {
+        return lua_toboolean(L, index);
+    }
+};
+
+template<>
+struct luawt_Arg<int> {
+    static const char* type() {
+        return "int";
+    }
+
+    static int get(lua_State* L, int index) {
+        return lua_tointeger(L, index);
+    }
+};
+
+template<>
+struct luawt_Arg<double> {
+    static const char* type() {
+        return "double";
+    }
+
+    static double get(lua_State* L, int index) {
+        return lua_tonumber(L, index);
+    }
+};
+
+template<>
+struct luawt_Arg<const char*> {
+    static const char* type() {
+        return "char const *";
+    }
+
+    static const char* get(lua_State* L, int index) {
+        return lua_tostring(L, index);
+    }
+};
+
+template<>
+struct luawt_Arg<std::string> {
+    static const char* type() {
+        return "char const *";
+    }
+
+    static std::string get(lua_State* L, int index) {
+        return luawt_toStdString(L, index);
+    }
+};
+
+template<>
+struct luawt_Arg<Wt::WString> {
+    static const char* type() {
+        return "char const *";
+    }
+
+    static Wt::WString get(lua_State* L, int index) {
+        return luawt_toWString(L, index);
+    }
+};
+
+template<>
+struct luawt_Arg<Wt::WLink> {
+    static const char* type() {
+        return "char const *";
+    }
+
+    static Wt::WLink get(lua_State* L, int index) {
+        return Wt::WLink(luawt_toStdString(L, index));
+    }
+};
+
+template<>
+struct luawt_Arg<Wt::WLength> {
+    static const char* type() {
+        return "double";
+    }
+
+    static Wt::WLength get(lua_State* L, int index) {
+        return Wt::WLength(lua_tonumber(L, index));
+    }
+};
+
+/* Conversion of a result of type R to Lua. push() returns the
+   number of pushed values. The generic case is a widget pointer.
+*/
+template<typename R>
+struct luawt_Result;
+
+template<typename T>
+struct luawt_Result<T*> {
+    static int push(lua_State* L, T* value) {
+        luawt_toLua(L, value);
+        return 1;
+    }
+};
+
+template<typename T>
+struct luawt_Result<T&> {
+    static int push(lua_State* L, T& value) {
+        luawt_toLua(L, &value);
+        return 1;
+    }
+};
+
+template<typename T>
+struct luawt_Result<const T&>: luawt_Result<T> {
+};
+
+template<typename T>
+struct luawt_Result<const T>: luawt_Result<T> {
+};
+
+template<>
+struct luawt_Result<bool> {
+    static int push(lua_State* L, bool value) {
+        lua_pushboolean(L, value);
+        return 1;
+    }
+};
+
+template<>
+struct luawt_Result<int> {
+    static int push(lua_State* L, int value) {
+        lua_pushinteger(L, value);
+        return 1;
+    }
+};
+
+template<>
+struct luawt_Result<double> {
+    static int push(lua_State* L, double value) {
+        lua_pushnumber(L, value);
+        return 1;
+    }
+};
+
+template<>
+struct luawt_Result<std::string> {
+    static int push(lua_State* L, const std::string& value) {
+        luawt_pushString(L, value);
+        return 1;
+    }
+};
+
+template<>
+struct luawt_Result<Wt::WString> {
+    static int push(lua_State* L, const Wt::WString& value) {
+        luawt_pushString(L, value.toUTF8());
+        return 1;
+    }
+};
+
+template<>
+struct luawt_Result<Wt::WLink> {
+    static int push(lua_State* L, const Wt::WLink& value) {
+        luawt_pushString(L, value.url());
+        return 1;
+    }
+};
+
+template<>
+struct luawt_Result<Wt::WLength> {
+    static int push(lua_State* L, const Wt::WLength& value) {
+        lua_pushnumber(L, value.value());
+        return 1;
+    }
+};
+
+/* Raises "Wrong arguments for Klass.method", like generated
+   functions.
+*/
+inline int luawt_wrongArguments(lua_State* L, const char* name) {
+    return luaL_error(L, "Wrong arguments for %s", name);
+}
+
+/* Binding of member function of type F, specialized below for
+   0-4 arguments, const methods and void results. call<f> calls
+   method f with arguments from Lua; name is used in errors.
+*/
+template<typename F>
+struct luawt_Method;
+
+template<typename C, typename R>
+struct luawt_Method<R (C::*)()> {
+    typedef R (C::*F)();
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)());
+    }
+};
+
+template<typename C>
+struct luawt_Method<void (C::*)()> {
+    typedef void (C::*F)();
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)();
+        return 0;
+    }
+};
+
+template<typename C, typename R>
+struct luawt_Method<R (C::*)() const> {
+    typedef R (C::*F)() const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)());
+    }
+};
+
+template<typename C>
+struct luawt_Method<void (C::*)() const> {
+    typedef void (C::*F)() const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)();
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1>
+struct luawt_Method<R (C::*)(A1)> {
+    typedef R (C::*F)(A1);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), luawt_Arg<A1>::type(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(luawt_Arg<A1>::get(L, 2)));
+    }
+};
+
+template<typename C, typename A1>
+struct luawt_Method<void (C::*)(A1)> {
+    typedef void (C::*F)(A1);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), luawt_Arg<A1>::type(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(luawt_Arg<A1>::get(L, 2));
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1>
+struct luawt_Method<R (C::*)(A1) const> {
+    typedef R (C::*F)(A1) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), luawt_Arg<A1>::type(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(luawt_Arg<A1>::get(L, 2)));
+    }
+};
+
+template<typename C, typename A1>
+struct luawt_Method<void (C::*)(A1) const> {
+    typedef void (C::*F)(A1) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {luawt_typeToStr<C>(), luawt_Arg<A1>::type(), NULL};
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(luawt_Arg<A1>::get(L, 2));
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1, typename A2>
+struct luawt_Method<R (C::*)(A1, A2)> {
+    typedef R (C::*F)(A1, A2);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3)
+        ));
+    }
+};
+
+template<typename C, typename A1, typename A2>
+struct luawt_Method<void (C::*)(A1, A2)> {
+    typedef void (C::*F)(A1, A2);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3)
+        );
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1, typename A2>
+struct luawt_Method<R (C::*)(A1, A2) const> {
+    typedef R (C::*F)(A1, A2) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3)
+        ));
+    }
+};
+
+template<typename C, typename A1, typename A2>
+struct luawt_Method<void (C::*)(A1, A2) const> {
+    typedef void (C::*F)(A1, A2) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3)
+        );
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1, typename A2, typename A3>
+struct luawt_Method<R (C::*)(A1, A2, A3)> {
+    typedef R (C::*F)(A1, A2, A3);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4)
+        ));
+    }
+};
+
+template<typename C, typename A1, typename A2, typename A3>
+struct luawt_Method<void (C::*)(A1, A2, A3)> {
+    typedef void (C::*F)(A1, A2, A3);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4)
+        );
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1, typename A2, typename A3>
+struct luawt_Method<R (C::*)(A1, A2, A3) const> {
+    typedef R (C::*F)(A1, A2, A3) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4)
+        ));
+    }
+};
+
+template<typename C, typename A1, typename A2, typename A3>
+struct luawt_Method<void (C::*)(A1, A2, A3) const> {
+    typedef void (C::*F)(A1, A2, A3) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4)
+        );
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1, typename A2, typename A3, typename A4>
+struct luawt_Method<R (C::*)(A1, A2, A3, A4)> {
+    typedef R (C::*F)(A1, A2, A3, A4);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            luawt_Arg<A4>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4),
+            luawt_Arg<A4>::get(L, 5)
+        ));
+    }
+};
+
+template<typename C, typename A1, typename A2, typename A3, typename A4>
+struct luawt_Method<void (C::*)(A1, A2, A3, A4)> {
+    typedef void (C::*F)(A1, A2, A3, A4);
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            luawt_Arg<A4>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4),
+            luawt_Arg<A4>::get(L, 5)
+        );
+        return 0;
+    }
+};
+
+template<typename C, typename R, typename A1, typename A2, typename A3, typename A4>
+struct luawt_Method<R (C::*)(A1, A2, A3, A4) const> {
+    typedef R (C::*F)(A1, A2, A3, A4) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            luawt_Arg<A4>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        return luawt_Result<R>::push(L, (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4),
+            luawt_Arg<A4>::get(L, 5)
+        ));
+    }
+};
+
+template<typename C, typename A1, typename A2, typename A3, typename A4>
+struct luawt_Method<void (C::*)(A1, A2, A3, A4) const> {
+    typedef void (C::*F)(A1, A2, A3, A4) const;
+
+    template<F f>
+    static int call(lua_State* L, const char* name) {
+        const char* group[] = {
+            luawt_typeToStr<C>(),
+            luawt_Arg<A1>::type(),
+            luawt_Arg<A2>::type(),
+            luawt_Arg<A3>::type(),
+            luawt_Arg<A4>::type(),
+            NULL
+        };
+        if (!luawt_checkArgsGroup(L, group)) {
+            return luawt_wrongArguments(L, name);
+        }
+        C* self = luawt_checkFromLua<C>(L, 1);
+        (self->*f)(
+            luawt_Arg<A1>::get(L, 2),
+            luawt_Arg<A2>::get(L, 3),
+            luawt_Arg<A3>::get(L, 4),
+            luawt_Arg<A4>::get(L, 5)
+        );
+        return 0;
+    }
+};
+
+/* Deduces the type of member function pointer for BIND_METHOD. */
+template<typename F>
+inline luawt_Method<F> luawt_method(F) {
+    return luawt_Method<F>();
+}
+
+#define BIND_METHOD(Klass, method) \
+    int luawt_##Klass##_##method(lua_State* L) { \
+        return luawt_method(&Klass::method).call<&Klass::method>( \
+            L, \
+            #Klass "." #method \
+        ); \
+    }
+
+#endif
@@ -0,0 +1,233 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+
+/* Allocator of session states. A state is used by one thread at
+   a time (the session's lock is held), so the counters need no
+   synchronization. Allocations which would exceed the limit fail,
+   Lua collects garbage and raises "not enough memory" if that
+   doesn't help. Shrinking never fails, as Lua requires.
+*/
+static void* luawt_alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    luawt_MemoryUsage* usage = reinterpret_cast<luawt_MemoryUsage*>(ud);
+    if (!ptr) {
+        osize = 0; // type of the object in Lua 5.2+
+    }
+    if (nsize == 0) {
+        free(ptr);
+        usage->used -= osize;
+        return 0;
+    }
+    if (nsize > osize && usage->limit &&
+            usage->used - osize + nsize > usage->limit) {
+        luawt_count(COUNTER_ALLOCATIONS_REFUSED);
+        return 0;
+    }
+    void* result = realloc(ptr, nsize);
+    if (result) {
+        usage->used = usage->used - osize + nsize;
+        if (usage->used > usage->peak) {
+            usage->peak = usage->used;
+        }
+    }
+    return result;
+}
+
+static int luawt_panic(lua_State* L) {
+    fprintf(stderr, "PANIC: unprotected error in call to Lua API (%s)\n",
+            lua_tostring(L, -1));
+    return 0;
+}
+
+lua_State* luawt_newState(luawt_MemoryUsage* usage) {
+    lua_State* L = lua_newstate(luawt_alloc, usage);
+    if (L) {
+        lua_atpanic(L, luawt_panic);
+    }
+    return L;
+}
+
+int luawt_cpcall(lua_State* L, lua_CFunction f, void* ud) {
+#if LUA_VERSION_NUM == 501
+    return lua_cpcall(L, f, ud);
+#else
+    // light C functions and light userdata are not allocated
+    lua_pushcfunction(L, f);
+    lua_pushlightuserdata(L, ud);
+    return lua_pcall(L, 1, 0, 0);
+#endif
+}
+
+int luawt_openSessionLibs(lua_State* L) {
+    void* shared = lua_touserdata(L, 1);
+    luaL_openlibs(L);
+    luawt_setShared(L, shared);
+#ifdef LUAWTEST
+    luaopen_luawtest(L);
+#else
+    luaopen_luawt(L);
+#endif
+    return 0;
+}
+
+int luawt_newTableRef(lua_State* L) {
+    int* reference = reinterpret_cast<int*>(lua_touserdata(L, 1));
+    lua_newtable(L);
+    *reference = luaL_ref(L, LUA_REGISTRYINDEX);
+    return 0;
+}
+
+struct luawt_AppRun {
+    MyApplication* app;
+    const std::string* bytecode;
+    void (*set_env)(lua_State*, MyApplication*);
+};
+
+/* Runs with luawt_cpcall. */
+static int luawt_runApp(lua_State* L) {
+    luawt_AppRun* run = reinterpret_cast<luawt_AppRun*>(lua_touserdata(L, 1));
+    lua_settop(L, 0);
+    const std::string& bytecode = *run->bytecode;
+    if (luaL_loadbuffer(L, bytecode.c_str(), bytecode.size(),
+                        "app") != LUA_OK) {
+        return lua_error(L);
+    }
+    if (run->set_env) {
+        run->set_env(L, run->app);
+    }
+    luawt_toLua<MyApplication>(L, run->app);
+    WEnvironment& env = const_cast<WEnvironment&>(run->app->environment());
+    luawt_toLua<WEnvironment>(L, &env);
+    lua_call(L, 2, 0);
+    return 0;
+}
+
+int MyApplication::runCode(
+    const std::string& bytecode,
+    void (*set_env)(lua_State*, MyApplication*)
+) {
+    luawt_AppRun run = {this, &bytecode, set_env};
+    luawt_Watchdog watchdog(L_, options_);
+    return luawt_cpcall(L_, luawt_runApp, &run);
+}
+
+static boost::mutex luawt_baseline_mutex;
+static size_t luawt_baseline = 0;
+
+size_t luawt_baselineMemory(void* shared) {
+    boost::mutex::scoped_lock lock(luawt_baseline_mutex);
+    if (!luawt_baseline) {
+        luawt_MemoryUsage usage = {0, 0, 0};
+        lua_State* L = luawt_newState(&usage);
+        if (!L) {
+            throw std::runtime_error("LuaWt: not enough memory "
+                                     "for Lua state");
+        }
+        int status = luawt_cpcall(L, luawt_openSessionLibs, shared);
+        size_t used = usage.used;
+        lua_close(L);
+        if (status != LUA_OK) {
+            throw std::runtime_error("LuaWt: unable to open Lua state");
+        }
+        luawt_baseline = used;
+    }
+    return luawt_baseline;
+}
+
+void luawt_configureGc(lua_State* L, const luawt_AppOptions& options) {
+#if LUA_VERSION_NUM >= 504
+    if (options.gc_generational) {
+        lua_gc(L, LUA_GCGEN, 0, 0);
+    } else {
+        lua_gc(L, LUA_GCINC, options.gc_pause, options.gc_stepmul, 0);
+    }
+#else
+    if (options.gc_pause) {
+        lua_gc(L, LUA_GCSETPAUSE, options.gc_pause);
+    }
+    if (options.gc_stepmul) {
+        lua_gc(L, LUA_GCSETSTEPMUL, options.gc_stepmul);
+    }
+#endif
+}
+
+static void luawt_runGcStep() {
+    MyApplication* app = MyApplication::instance();
+    if (app) {
+        app->gcStep();
+    }
+}
+
+/* WServer runs the posted function after the current request
+   of the session has been completed and its lock released.
+*/
+void MyApplication::postGcStep() {
+    WServer* server = WServer::instance();
+    if (server) {
+        gc_step_posted_ = true;
+        server->post(sessionId(), boost::bind(luawt_runGcStep));
+    }
+}
+
+void MyApplication::gcStep() {
+    last_event_ = previous_event_; // not an event of the user
+    gc_step_posted_ = false;
+    gc_step_done_ = true;
+    if (L_) {
+        luawt_Timer timer(METRIC_GC_STEP);
+        lua_gc(L_, LUA_GCSTEP, options_.gc_idle_step);
+    }
+}
+
+/** Returns memory of the current Lua state
+    Table with fields used, peak and limit in bytes. Peak and limit
+    are known if the state was created with option
+    session_memory_limit of WServer, otherwise they are nil.
+    Limit is nil if there is no limit.
+*/
+int luawt_Memory_memory(lua_State* L) {
+    void* ud;
+    lua_Alloc alloc = lua_getallocf(L, &ud);
+    lua_newtable(L);
+    if (alloc == luawt_alloc) {
+        luawt_MemoryUsage* usage = reinterpret_cast<luawt_MemoryUsage*>(ud);
+        lua_pushnumber(L, usage->used);
+        lua_setfield(L, -2, "used");
+        lua_pushnumber(L, usage->peak);
+        lua_setfield(L, -2, "peak");
+        if (usage->limit) {
+            lua_pushnumber(L, usage->limit);
+            lua_setfield(L, -2, "limit");
+        }
+    } else {
+        lua_Number used = lua_gc(L, LUA_GCCOUNT, 0) * 1024.0 +
+                          lua_gc(L, LUA_GCCOUNTB, 0);
+        lua_pushnumber(L, used);
+        lua_setfield(L, -2, "used");
+    }
+    return 1;
+}
+
+static const luaL_Reg luawt_Memory_functions[] = {
+    METHOD(Memory, memory),
+    {NULL, NULL},
+};
+
+void luawt_Memory(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    my_setfuncs(L, luawt_Memory_functions);
+    lua_pop(L, 1); // luawt
+}
@@ -0,0 +1,263 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "boost-xtime.hpp"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <Wt/Http/Request>
+#include <Wt/Http/Response>
+#include <Wt/WResource>
+
+#include "globals.hpp"
+#include "metrics.hpp"
+
+bool luawt_time_bindings = false;
+
+static const struct {
+    const char* name; // in server:stats()
+    const char* prometheus_name;
+    double prometheus_scale; // from units of the metric
+} luawt_metrics[METRIC_COUNT] = {
+    {"session_create", "luawt_session_create_seconds", 1e-6},
+    {"event", "luawt_event_seconds", 1e-6},
+    {"slot", "luawt_slot_seconds", 1e-6},
+    {"binding", "luawt_binding_seconds", 1e-6},
+    {"shared_lock", "luawt_shared_lock_seconds", 1e-6},
+    {"lua_memory", "luawt_lua_memory_bytes", 1024},
+    {
+        "session_memory_peak", "luawt_session_memory_peak_bytes", 1024
+    },
+    {"gc_step", "luawt_gc_step_seconds", 1e-6},
+};
+
+static const struct {
+    const char* name;
+    const char* prometheus_name;
+} luawt_counters[COUNTER_COUNT] = {
+    {"sessions_created", "luawt_sessions_created_total"},
+    {"sessions_destroyed", "luawt_sessions_destroyed_total"},
+    {"session_errors", "luawt_session_errors_total"},
+    {"sessions_rejected", "luawt_sessions_rejected_total"},
+    {"slot_errors", "luawt_slot_errors_total"},
+    {"allocations_refused", "luawt_allocations_refused_total"},
+    {"sessions_hibernated", "luawt_sessions_hibernated_total"},
+    {"handlers_aborted", "luawt_handlers_aborted_total"},
+};
+
+struct luawt_Metrics {
+    luawt_Metrics() {
+        memset(buckets, 0, sizeof(buckets));
+        memset(sums, 0, sizeof(sums));
+        memset(counters, 0, sizeof(counters));
+    }
+
+    void add(const luawt_Metrics& other) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            for (int b = 0; b < METRIC_BUCKETS; b++) {
+                buckets[m][b] += other.buckets[m][b];
+            }
+            sums[m] += other.sums[m];
+        }
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            counters[c] += other.counters[c];
+        }
+    }
+
+    long long count(int metric) const {
+        long long result = 0;
+        for (int b = 0; b < METRIC_BUCKETS; b++) {
+            result += buckets[metric][b];
+        }
+        return result;
+    }
+
+    /* Returns upper bound of the bucket with the quantile. */
+    long long quantile(int metric, double q) const {
+        long long rank = static_cast<long long>(count(metric) * q);
+        long long seen = 0;
+        for (int b = 0; b < METRIC_BUCKETS - 1; b++) {
+            seen += buckets[metric][b];
+            if (seen > rank) {
+                return 1LL << b;
+            }
+        }
+        return 1LL << (METRIC_BUCKETS - 1);
+    }
+
+    long long buckets[METRIC_COUNT][METRIC_BUCKETS];
+    long long sums[METRIC_COUNT];
+    long long counters[COUNTER_COUNT];
+};
+
+/* Each thread records into its own buffer, so the mutex of
+   the buffer is contended only while stats are being read.
+   Buffers are never freed: totals must survive the threads,
+   and the number of threads of the server is bounded.
+*/
+struct luawt_MetricsBuffer {
+    boost::mutex mutex;
+    luawt_Metrics metrics;
+};
+
+typedef std::vector<luawt_MetricsBuffer*> Buffers;
+
+static boost::mutex& luawt_buffersMutex() {
+    static boost::mutex mutex;
+    return mutex;
+}
+
+static Buffers& luawt_buffers() {
+    static Buffers buffers;
+    return buffers;
+}
+
+static void luawt_keepBuffer(luawt_MetricsBuffer*) {
+}
+
+static boost::thread_specific_ptr<luawt_MetricsBuffer>
+luawt_thread_buffer(luawt_keepBuffer);
+
+static luawt_MetricsBuffer* luawt_threadBuffer() {
+    luawt_MetricsBuffer* buffer = luawt_thread_buffer.get();
+    if (!buffer) {
+        buffer = new luawt_MetricsBuffer;
+        {
+            boost::mutex::scoped_lock lock(luawt_buffersMutex());
+            luawt_buffers().push_back(buffer);
+        }
+        luawt_thread_buffer.reset(buffer);
+    }
+    return buffer;
+}
+
+static int luawt_bucket(long long value) {
+    int bucket = 0;
+    while (value > 0 && bucket < METRIC_BUCKETS - 1) {
+        value >>= 1;
+        bucket += 1;
+    }
+    return bucket;
+}
+
+void luawt_record(luawt_Metric metric, long long value) {
+    luawt_MetricsBuffer* buffer = luawt_threadBuffer();
+    int bucket = luawt_bucket(value);
+    boost::mutex::scoped_lock lock(buffer->mutex);
+    buffer->metrics.buckets[metric][bucket] += 1;
+    buffer->metrics.sums[metric] += value;
+}
+
+void luawt_count(luawt_Counter counter) {
+    luawt_MetricsBuffer* buffer = luawt_threadBuffer();
+    boost::mutex::scoped_lock lock(buffer->mutex);
+    buffer->metrics.counters[counter] += 1;
+}
+
+static luawt_Metrics luawt_collectMetrics() {
+    luawt_Metrics total;
+    Buffers buffers;
+    {
+        boost::mutex::scoped_lock lock(luawt_buffersMutex());
+        buffers = luawt_buffers();
+    }
+    for (size_t i = 0; i < buffers.size(); i++) {
+        boost::mutex::scoped_lock lock(buffers[i]->mutex);
+        total.add(buffers[i]->metrics);
+    }
+    return total;
+}
+
+static long long luawt_liveSessions(const luawt_Metrics& metrics) {
+    return metrics.counters[COUNTER_SESSIONS_CREATED] -
+           metrics.counters[COUNTER_SESSIONS_DESTROYED];
+}
+
+long long luawt_liveSessions() {
+    return luawt_liveSessions(luawt_collectMetrics());
+}
+
+/* Table of stats:
+   - counters (sessions_created, ...) and sessions_live,
+   - histograms (session_create, ...): tables with count, sum,
+     p50, p90, p99 and buckets (buckets[i] is number of values
+     less than 2^(i-1), not cumulative). Quantiles are upper
+     bounds of their buckets.
+*/
+void luawt_pushStats(lua_State* L) {
+    luawt_Metrics metrics = luawt_collectMetrics();
+    lua_newtable(L);
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        lua_pushnumber(L, metrics.counters[c]);
+        lua_setfield(L, -2, luawt_counters[c].name);
+    }
+    lua_pushnumber(L, luawt_liveSessions(metrics));
+    lua_setfield(L, -2, "sessions_live");
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        lua_newtable(L);
+        lua_pushnumber(L, metrics.count(m));
+        lua_setfield(L, -2, "count");
+        lua_pushnumber(L, metrics.sums[m]);
+        lua_setfield(L, -2, "sum");
+        lua_pushnumber(L, metrics.quantile(m, 0.5));
+        lua_setfield(L, -2, "p50");
+        lua_pushnumber(L, metrics.quantile(m, 0.9));
+        lua_setfield(L, -2, "p90");
+        lua_pushnumber(L, metrics.quantile(m, 0.99));
+        lua_setfield(L, -2, "p99");
+        lua_newtable(L);
+        for (int b = 0; b < METRIC_BUCKETS; b++) {
+            lua_pushnumber(L, metrics.buckets[m][b]);
+            lua_rawseti(L, -2, b + 1);
+        }
+        lua_setfield(L, -2, "buckets");
+        lua_setfield(L, -2, luawt_metrics[m].name);
+    }
+}
+
+class luawt_MetricsResource : public WResource {
+public:
+    ~luawt_MetricsResource() {
+        beingDeleted();
+    }
+
+    void handleRequest(
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        luawt_Metrics metrics = luawt_collectMetrics();
+        response.setMimeType("text/plain; version=0.0.4");
+        std::ostream& out = response.out();
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            const char* name = luawt_counters[c].prometheus_name;
+            out << "# TYPE " << name << " counter\n";
+            out << name << " " << metrics.counters[c] << "\n";
+        }
+        out << "# TYPE luawt_sessions_live gauge\n";
+        out << "luawt_sessions_live " << luawt_liveSessions(metrics) << "\n";
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            const char* name = luawt_metrics[m].prometheus_name;
+            double scale = luawt_metrics[m].prometheus_scale;
+            out << "# TYPE " << name << " histogram\n";
+            long long cumulative = 0;
+            for (int b = 0; b < METRIC_BUCKETS - 1; b++) {
+                cumulative += metrics.buckets[m][b];
+                out << name << "_bucket{le=\"" << (1LL << b) * scale
+                    << "\"} " << cumulative << "\n";
+            }
+            out << name << "_bucket{le=\"+Inf\"} " << metrics.count(m)
+                << "\n";
+            out << name << "_sum " << metrics.sums[m] * scale << "\n";
+            out << name << "_count " << metrics.count(m) << "\n";
+        }
+    }
+};
+
+WResource* luawt_makeMetricsResource() {
+    return new luawt_MetricsResource;
+}
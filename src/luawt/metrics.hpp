@@ -0,0 +1,106 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#ifndef METRICS_HPP_
+#define METRICS_HPP_
+
+#include <time.h>
+
+#include "boost-xtime.hpp"
+#include <boost/thread/mutex.hpp>
+
+struct lua_State;
+
+namespace Wt {
+class WResource;
+}
+
+/* Histograms recorded by luawt. Times are in microseconds. */
+enum luawt_Metric {
+    METRIC_SESSION_CREATE, // luawt_AppCreator: new state + app code
+    METRIC_EVENT, // handling of a request by a session
+    METRIC_SLOT, // Lua slot called by Wt
+    METRIC_BINDING, // bound C function (if enabled)
+    METRIC_SHARED_LOCK, // waiting for lock of luawt.Shared
+    METRIC_LUA_MEMORY, // memory of lua_State after slot, kilobytes
+    METRIC_SESSION_MEMORY_PEAK, // peak of tracked lua_State, kilobytes
+    METRIC_GC_STEP, // GC step of a session after an event
+    METRIC_COUNT,
+};
+
+enum luawt_Counter {
+    COUNTER_SESSIONS_CREATED,
+    COUNTER_SESSIONS_DESTROYED,
+    COUNTER_SESSION_ERRORS,
+    COUNTER_SESSIONS_REJECTED, // by admission control
+    COUNTER_SLOT_ERRORS,
+    COUNTER_ALLOCATIONS_REFUSED, // by session_memory_limit
+    COUNTER_SESSIONS_HIBERNATED,
+    COUNTER_HANDLERS_ABORTED, // by handler_instructions or handler_timeout
+    COUNTER_COUNT,
+};
+
+/* Bucket i counts values less than 2^i, the last one the rest. */
+const int METRIC_BUCKETS = 26;
+
+/* Microseconds of monotonic clock. */
+inline long long luawt_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+void luawt_record(luawt_Metric metric, long long value);
+
+void luawt_count(luawt_Counter counter);
+
+/* Sessions created minus sessions destroyed. */
+long long luawt_liveSessions();
+
+/* Timing of binding calls costs two clock reads per call,
+   so it is off by default.
+*/
+extern bool luawt_time_bindings;
+
+/* Records time from construction to destruction. */
+class luawt_Timer {
+public:
+    luawt_Timer(luawt_Metric metric, bool enabled = true):
+        metric_(metric), start_(enabled ? luawt_now() : 0) {
+    }
+
+    ~luawt_Timer() {
+        if (start_) {
+            luawt_record(metric_, luawt_now() - start_);
+        }
+    }
+
+private:
+    luawt_Metric metric_;
+    long long start_;
+};
+
+/* Lock of boost::mutex which records the waiting time. */
+class luawt_TimedLock {
+public:
+    luawt_TimedLock(boost::mutex& mtx):
+        lock_(mtx, boost::defer_lock) {
+        long long start = luawt_now();
+        lock_.lock();
+        luawt_record(METRIC_SHARED_LOCK, luawt_now() - start);
+    }
+
+private:
+    boost::mutex::scoped_lock lock_;
+};
+
+/* Pushes table with all metrics (see metrics.cpp). */
+void luawt_pushStats(lua_State* L);
+
+/* Creates resource which serves metrics in Prometheus text format. */
+Wt::WResource* luawt_makeMetricsResource();
+
+#endif
@@ -0,0 +1,213 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <string>
+#include <vector>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <Wt/WLogger>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+#include "server.hpp"
+
+/* Userdata kept in the registry table of the session.
+   Its __gc removes the session from the registered targets.
+*/
+struct luawt_SessionEntry {
+    std::string id;
+};
+
+static int luawt_SessionEntry_gc(lua_State* L) {
+    luawt_SessionEntry* entry = reinterpret_cast<luawt_SessionEntry*>(
+            lua_touserdata(L, 1)
+        );
+    luawt_unregisterPostTarget(entry->id);
+    entry->~luawt_SessionEntry();
+    return 0;
+}
+
+struct luawt_HandlerCall {
+    MyApplication* app;
+    const std::string* name;
+    const std::string* payload;
+    bool found;
+};
+
+/* Finds the handler and calls it with the payload. Runs with
+   luawt_cpcall, since the memory limit of the session may refuse
+   any allocation, including ones made by the lookup and the payload.
+*/
+static int luawt_callHandler(lua_State* L) {
+    luawt_HandlerCall* call = reinterpret_cast<luawt_HandlerCall*>(
+            lua_touserdata(L, 1)
+        );
+    lua_settop(L, 0);
+    call->app->pushRegistry(L);
+    lua_getfield(L, 1, "handlers");
+    if (lua_isnil(L, -1)) {
+        return 0;
+    }
+    lua_getfield(L, 2, call->name->c_str());
+    if (lua_isnil(L, -1)) {
+        return 0;
+    }
+    call->found = true;
+    if (!luawt_deserialize(L, call->payload->c_str(),
+                           call->payload->size())) {
+        lua_pushnil(L);
+    }
+    lua_call(L, 1, 0);
+    return 0;
+}
+
+/* Runs in the target session. */
+static void luawt_runHandler(
+    const std::string& name,
+    const std::string& payload
+) {
+    MyApplication* app = MyApplication::instance();
+    if (!app) {
+        return;
+    }
+    lua_State* L = app->L();
+    luawt_HandlerCall call;
+    call.app = app;
+    call.name = &name;
+    call.payload = &payload;
+    call.found = false;
+    int status;
+    {
+        luawt_Watchdog watchdog(L, app->options());
+        status = luawt_cpcall(L, luawt_callHandler, &call);
+    }
+    if (status == LUA_OK && !call.found) {
+        Wt::log("warning") << "luawt: no handler '" << name
+                           << "' in session " << app->sessionId();
+        return;
+    }
+    if (status != LUA_OK) {
+        Wt::log("error") << "luawt: handler '" << name << "': "
+                         << lua_tostring(L, -1);
+        lua_pop(L, 1);
+    }
+    app->triggerUpdate();
+}
+
+static void luawt_removeSession(const std::string& id) {
+    luawt_unregisterPostTarget(id);
+}
+
+static void luawt_postToSession(
+    const std::string& id,
+    const std::string& name,
+    const std::string& payload
+) {
+    WServer* server = WServer::instance();
+    if (!server) {
+        throw std::logic_error("LuaWt: no WServer to post to");
+    }
+    server->post(
+        id,
+        boost::bind(luawt_runHandler, name, payload),
+        boost::bind(luawt_removeSession, id)
+    );
+}
+
+/** Registers handler which other sessions can run in this one
+    Argument 1 is the name, argument 2 is fn(payload).
+    Must be called from a session. Updates are enabled, so changes
+    made by the handler are pushed to the browser.
+*/
+int luawt_Post_handle(lua_State* L) {
+    luaL_checkstring(L, 1);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    MyApplication* app = MyApplication::instance();
+    // L is the state of the session or its slot coroutine
+    if (!luawt_isSessionState(app, L)) {
+        throw std::logic_error("LuaWt: luawt.handle must be called "
+                               "from a session");
+    }
+    app->pushRegistry(L);
+    int registry = lua_gettop(L);
+    lua_getfield(L, registry, "handlers");
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        lua_newtable(L);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, registry, "handlers");
+        // register the session once, with the first handler
+        luawt_SessionEntry* entry = reinterpret_cast<luawt_SessionEntry*>(
+                lua_newuserdata(L, sizeof(luawt_SessionEntry))
+            );
+        new (entry) luawt_SessionEntry();
+        entry->id = app->sessionId();
+        lua_newtable(L); // metatable
+        lua_pushcfunction(L, luawt_SessionEntry_gc);
+        lua_setfield(L, -2, "__gc");
+        lua_setmetatable(L, -2);
+        lua_setfield(L, registry, "session_entry");
+        luawt_registerPostTarget(entry->id);
+        if (!app->updatesEnabled()) {
+            app->enableUpdates(true);
+        }
+    }
+    lua_pushvalue(L, 1);
+    lua_pushvalue(L, 2);
+    lua_rawset(L, -3);
+    lua_pop(L, 2); // handlers, registry of the session
+    return 0;
+}
+
+/** Runs a handler in another session
+    Arguments: session ID, name of handler, payload (any value
+    which luawt.serialize accepts).
+    Can be called from any thread. The handler runs asynchronously
+    in the target session. Returns false if the session has no
+    handlers (or doesn't exist).
+*/
+int luawt_Post_post(lua_State* L) {
+    // luaL_check* before std::string: its errors skip destructors
+    const char* id = luaL_checkstring(L, 1);
+    const char* name = luaL_checkstring(L, 2);
+    std::string payload = luawt_checkSerialized(L, 3);
+    bool found = luawt_isPostTarget(id);
+    if (found) {
+        luawt_postToSession(id, name, payload);
+    }
+    lua_pushboolean(L, found);
+    return 1;
+}
+
+/** Runs a handler in all sessions which have handlers
+    Arguments: name of handler, payload.
+    Returns number of sessions.
+*/
+int luawt_Post_broadcast(lua_State* L) {
+    const char* name = luaL_checkstring(L, 1);
+    std::string payload = luawt_checkSerialized(L, 2);
+    std::vector<std::string> ids = luawt_postTargets();
+    for (size_t i = 0; i < ids.size(); i++) {
+        luawt_postToSession(ids[i], name, payload);
+    }
+    lua_pushinteger(L, ids.size());
+    return 1;
+}
+
+static const luaL_Reg luawt_Post_functions[] = {
+    METHOD(Post, handle),
+    METHOD(Post, post),
+    METHOD(Post, broadcast),
+    {NULL, NULL},
+};
+
+void luawt_Post(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    my_setfuncs(L, luawt_Post_functions);
+    lua_pop(L, 1); // luawt
+}
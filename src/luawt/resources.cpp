@@ -0,0 +1,289 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <iterator>
+#include <map>
+#include <string>
+
+#include "boost-xtime.hpp"
+#include <boost/any.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <Wt/Http/Request>
+#include <Wt/Http/Response>
+#include <Wt/Http/ResponseContinuation>
+#include <Wt/WLogger>
+#include <Wt/WResource>
+
+#include "globals.hpp"
+#include "server.hpp"
+
+/* Lua state of a worker thread. Resources don't have sessions,
+   so instead of a state per request each thread has its own state,
+   created on first use and closed when the thread exits.
+   Handlers are loaded once per thread.
+*/
+struct luawt_ThreadState {
+    luawt_ThreadState(void* shared) {
+        L = luaL_newstate();
+        luaL_openlibs(L);
+        luawt_setShared(L, shared);
+        luaopen_luawt(L);
+        lua_pop(L, 1); // luawt
+    }
+
+    ~luawt_ThreadState() {
+        lua_close(L);
+    }
+
+    lua_State* L;
+    /* ID of resource -> registry reference to its handler. */
+    std::map<int, int> handlers;
+};
+
+static boost::thread_specific_ptr<luawt_ThreadState> luawt_thread_state;
+
+static int luawt_nextResourceId() {
+    static boost::mutex mtx;
+    static int last_id = 0;
+    boost::mutex::scoped_lock lock(mtx);
+    last_id += 1;
+    return last_id;
+}
+
+static Http::Request* luawt_upRequest(lua_State* L) {
+    return reinterpret_cast<Http::Request*>(
+            lua_touserdata(L, lua_upvalueindex(1))
+        );
+}
+
+static Http::Response* luawt_upResponse(lua_State* L) {
+    return reinterpret_cast<Http::Response*>(
+            lua_touserdata(L, lua_upvalueindex(1))
+        );
+}
+
+/* Functions of request and response objects are called with
+   colon syntax, so argument 1 is the object itself.
+*/
+
+int luawt_Request_header(lua_State* L) {
+    const char* name = luaL_checkstring(L, 2);
+    std::string value = luawt_upRequest(L)->headerValue(name);
+    lua_pushlstring(L, value.c_str(), value.size());
+    return 1;
+}
+
+int luawt_Response_setStatus(lua_State* L) {
+    luawt_upResponse(L)->setStatus(luaL_checkinteger(L, 2));
+    return 0;
+}
+
+int luawt_Response_setMimeType(lua_State* L) {
+    luawt_upResponse(L)->setMimeType(luaL_checkstring(L, 2));
+    return 0;
+}
+
+int luawt_Response_addHeader(lua_State* L) {
+    const char* name = luaL_checkstring(L, 2);
+    const char* value = luaL_checkstring(L, 3);
+    luawt_upResponse(L)->addHeader(name, value);
+    return 0;
+}
+
+/* Writes all the arguments to the response. */
+int luawt_Response_write(lua_State* L) {
+    std::ostream& out = luawt_upResponse(L)->out();
+    int top = lua_gettop(L);
+    for (int i = 2; i <= top; i++) {
+        size_t len;
+        const char* data = luaL_checklstring(L, i, &len);
+        out.write(data, len);
+    }
+    return 0;
+}
+
+#define SET_CLOSURE_FIELD(ptr, Klass, field) \
+    lua_pushlightuserdata(L, ptr); \
+    lua_pushcclosure(L, wrap<luawt_##Klass##_##field>::func, 1); \
+    lua_setfield(L, -2, #field);
+
+static void luawt_setStringField(
+    lua_State* L,
+    const char* name,
+    const std::string& value
+) {
+    lua_pushlstring(L, value.c_str(), value.size());
+    lua_setfield(L, -2, name);
+}
+
+/* Request is a table: method, path, path_info, query_string,
+   client_address, content_type, content_length, body,
+   params (name -> first value), continuation (cursor returned
+   by previous call of the handler) and header(name).
+*/
+static void luawt_pushRequest(
+    lua_State* L,
+    const Http::Request& request,
+    const std::string* cursor
+) {
+    Http::Request* req = const_cast<Http::Request*>(&request);
+    lua_newtable(L);
+    luawt_setStringField(L, "method", request.method());
+    luawt_setStringField(L, "path", request.path());
+    luawt_setStringField(L, "path_info", request.pathInfo());
+    luawt_setStringField(L, "query_string", request.queryString());
+    luawt_setStringField(L, "client_address", request.clientAddress());
+    luawt_setStringField(L, "content_type", request.contentType());
+    lua_pushinteger(L, request.contentLength());
+    lua_setfield(L, -2, "content_length");
+    if (request.contentLength() > 0 && !cursor) {
+        std::string body(
+            (std::istreambuf_iterator<char>(request.in())),
+            std::istreambuf_iterator<char>()
+        );
+        luawt_setStringField(L, "body", body);
+    }
+    lua_newtable(L);
+    const Http::ParameterMap& params = request.getParameterMap();
+    for (Http::ParameterMap::const_iterator it = params.begin();
+            it != params.end(); ++it) {
+        if (!it->second.empty()) {
+            luawt_setStringField(L, it->first.c_str(), it->second[0]);
+        }
+    }
+    lua_setfield(L, -2, "params");
+    if (cursor) {
+        luawt_setStringField(L, "continuation", *cursor);
+    }
+    SET_CLOSURE_FIELD(req, Request, header)
+}
+
+static void luawt_pushResponse(lua_State* L, Http::Response& response) {
+    Http::Response* resp = &response;
+    lua_newtable(L);
+    SET_CLOSURE_FIELD(resp, Response, setStatus)
+    SET_CLOSURE_FIELD(resp, Response, setMimeType)
+    SET_CLOSURE_FIELD(resp, Response, addHeader)
+    SET_CLOSURE_FIELD(resp, Response, write)
+}
+
+/* Calls handler(request, response). The handler writes a chunk of
+   the response and returns nil if it is complete or a cursor
+   (string or number) to be called again with
+   request.continuation == cursor for the next chunk.
+   The next call can happen in another thread (and Lua state),
+   so the cursor is the only state kept between chunks.
+*/
+class luawt_LuaResource : public WResource {
+public:
+    luawt_LuaResource(
+        void* shared,
+        const std::string& code,
+        bool is_chunk
+    ):
+        shared_(shared),
+        code_(code),
+        is_chunk_(is_chunk),
+        id_(luawt_nextResourceId()) {
+    }
+
+    ~luawt_LuaResource() {
+        beingDeleted();
+    }
+
+    void handleRequest(
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        lua_State* L = threadState();
+        int top = lua_gettop(L);
+        try {
+            pushHandler(L);
+            const std::string* cursor = 0;
+            const Http::ResponseContinuation* continuation =
+                request.continuation();
+            // data() is not const and returns a copy: keep it alive
+            // while the cursor points into it
+            boost::any data;
+            if (continuation) {
+                data = const_cast<Http::ResponseContinuation*>(
+                           continuation
+                       )->data();
+                cursor = boost::any_cast<std::string>(&data);
+            }
+            luawt_pushRequest(L, request, cursor);
+            luawt_pushResponse(L, response);
+            int status = lua_pcall(L, 2, 1, 0);
+            checkPcallStatus(L, status);
+            size_t len;
+            const char* next = lua_tolstring(L, -1, &len);
+            if (next) {
+                Http::ResponseContinuation* c =
+                    response.createContinuation();
+                c->setData(std::string(next, len));
+            } else if (!lua_isnil(L, -1)) {
+                throw std::logic_error("LuaWt: handler of resource must "
+                                       "return nil or cursor");
+            }
+        } catch (std::exception& e) {
+            Wt::log("error") << "luawt: resource: " << e.what();
+            response.setStatus(500);
+        }
+        lua_settop(L, top);
+    }
+
+private:
+    void* shared_;
+    std::string code_;
+    bool is_chunk_;
+    int id_;
+
+    lua_State* threadState() const {
+        luawt_ThreadState* state = luawt_thread_state.get();
+        if (!state) {
+            state = new luawt_ThreadState(shared_);
+            luawt_thread_state.reset(state);
+        }
+        return state->L;
+    }
+
+    /* Pushes the handler, loading it into this thread's state. */
+    void pushHandler(lua_State* L) const {
+        std::map<int, int>& handlers = luawt_thread_state->handlers;
+        std::map<int, int>::const_iterator it = handlers.find(id_);
+        if (it != handlers.end()) {
+            lua_rawgeti(L, LUA_REGISTRYINDEX, it->second);
+            return;
+        }
+        int status = luaL_loadbuffer(
+                         L,
+                         code_.c_str(),
+                         code_.size(),
+                         "resource"
+                     );
+        checkPcallStatus(L, status);
+        if (is_chunk_) {
+            status = lua_pcall(L, 0, 1, 0);
+            checkPcallStatus(L, status);
+            if (lua_type(L, -1) != LUA_TFUNCTION) {
+                lua_pop(L, 1);
+                throw std::logic_error("LuaWt: code of resource must "
+                                       "return a function");
+            }
+        }
+        lua_pushvalue(L, -1);
+        handlers[id_] = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+};
+
+WResource* luawt_makeLuaResource(
+    void* shared,
+    const std::string& code,
+    bool is_chunk
+) {
+    return new luawt_LuaResource(shared, code, is_chunk);
+}
@@ -0,0 +1,317 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "globals.hpp"
+
+/* Format of serialized values. Each value starts with a tag:
+   - 'l' nil, 't' true, 'f' false,
+   - 'i' integer: zigzag varint,
+   - 'd' float: 8 bytes of double in the byte order of the machine,
+   - 's' string: varint length and bytes,
+   - 'T' table: keys and values, then 'e'.
+   Values are passed between states of one machine, so doubles
+   are copied as is.
+*/
+
+enum {
+    SERIALIZE_MAX_DEPTH = 100,
+};
+
+class luawt_Writer {
+public:
+    luawt_Writer(lua_State* L, std::string& out):
+        L_(L), out_(out) {
+    }
+
+    bool write(int index) {
+        switch (lua_type(L_, index)) {
+        case LUA_TNIL:
+            out_ += 'l';
+            return true;
+        case LUA_TBOOLEAN:
+            out_ += lua_toboolean(L_, index) ? 't' : 'f';
+            return true;
+        case LUA_TNUMBER:
+            writeNumber(index);
+            return true;
+        case LUA_TSTRING: {
+            size_t len;
+            const char* str = lua_tolstring(L_, index, &len);
+            out_ += 's';
+            writeVarint(len);
+            out_.append(str, len);
+            return true;
+        }
+        case LUA_TTABLE:
+            return writeTable(index);
+        default:
+            error_ = std::string("LuaWt: can't serialize ") +
+                     luaL_typename(L_, index);
+            return false;
+        }
+    }
+
+    const std::string& error() const {
+        return error_;
+    }
+
+private:
+    lua_State* L_;
+    std::string& out_;
+    std::string error_;
+    /* Tables being written, to detect cycles. */
+    std::vector<const void*> path_;
+
+    void writeVarint(unsigned long long value) {
+        while (value >= 0x80) {
+            out_ += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out_ += static_cast<char>(value);
+    }
+
+    void writeInteger(long long value) {
+        out_ += 'i';
+        unsigned long long u = static_cast<unsigned long long>(value);
+        writeVarint((u << 1) ^ (value < 0 ? ~0ULL : 0ULL));
+    }
+
+    void writeNumber(int index) {
+#if LUA_VERSION_NUM >= 503
+        if (lua_isinteger(L_, index)) {
+            writeInteger(lua_tointeger(L_, index));
+            return;
+        }
+#endif
+        double value = lua_tonumber(L_, index);
+#if LUA_VERSION_NUM < 503
+        if (value == floor(value) && fabs(value) < 9e15) {
+            writeInteger(static_cast<long long>(value));
+            return;
+        }
+#endif
+        out_ += 'd';
+        out_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    bool writeTable(int index) {
+        if (index < 0) {
+            index = lua_gettop(L_) + index + 1;
+        }
+        const void* table = lua_topointer(L_, index);
+        if (std::find(path_.begin(), path_.end(), table) != path_.end()) {
+            error_ = "LuaWt: can't serialize table with cycles";
+            return false;
+        }
+        if (path_.size() >= SERIALIZE_MAX_DEPTH || !lua_checkstack(L_, 2)) {
+            error_ = "LuaWt: table is too deep to serialize";
+            return false;
+        }
+        path_.push_back(table);
+        out_ += 'T';
+        lua_pushnil(L_);
+        while (lua_next(L_, index) != 0) {
+            if (!write(-2) || !write(-1)) {
+                lua_pop(L_, 2); // key, value
+                return false;
+            }
+            lua_pop(L_, 1); // value
+        }
+        out_ += 'e';
+        path_.pop_back();
+        return true;
+    }
+};
+
+class luawt_Reader {
+public:
+    luawt_Reader(lua_State* L, const char* data, size_t size):
+        L_(L), pos_(data), end_(data + size) {
+    }
+
+    bool read(int depth) {
+        if (pos_ == end_) {
+            return false;
+        }
+        char tag = *pos_++;
+        switch (tag) {
+        case 'l':
+            lua_pushnil(L_);
+            return true;
+        case 't':
+        case 'f':
+            lua_pushboolean(L_, tag == 't');
+            return true;
+        case 'i': {
+            unsigned long long u;
+            if (!readVarint(u)) {
+                return false;
+            }
+            long long value = static_cast<long long>(u >> 1);
+            if (u & 1) {
+                value = ~value;
+            }
+#if LUA_VERSION_NUM >= 503
+            lua_pushinteger(L_, value);
+#else
+            lua_pushnumber(L_, static_cast<lua_Number>(value));
+#endif
+            return true;
+        }
+        case 'd': {
+            double value;
+            if (end_ - pos_ < static_cast<ptrdiff_t>(sizeof(value))) {
+                return false;
+            }
+            memcpy(&value, pos_, sizeof(value));
+            pos_ += sizeof(value);
+            lua_pushnumber(L_, value);
+            return true;
+        }
+        case 's': {
+            unsigned long long len;
+            if (!readVarint(len) ||
+                    static_cast<unsigned long long>(end_ - pos_) < len) {
+                return false;
+            }
+            lua_pushlstring(L_, pos_, len);
+            pos_ += len;
+            return true;
+        }
+        case 'T':
+            return readTable(depth);
+        default:
+            return false;
+        }
+    }
+
+    bool finished() const {
+        return pos_ == end_;
+    }
+
+private:
+    lua_State* L_;
+    const char* pos_;
+    const char* end_;
+
+    bool readVarint(unsigned long long& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos_ == end_) {
+                return false;
+            }
+            unsigned char byte = *pos_++;
+            value |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* Leaves garbage on the stack on failure. */
+    bool readTable(int depth) {
+        if (depth >= SERIALIZE_MAX_DEPTH || !lua_checkstack(L_, 3)) {
+            return false;
+        }
+        lua_newtable(L_);
+        while (true) {
+            if (pos_ == end_) {
+                return false;
+            }
+            if (*pos_ == 'e') {
+                pos_++;
+                return true;
+            }
+            if (!read(depth + 1)) {
+                return false;
+            }
+            int key_type = lua_type(L_, -1);
+            if (key_type == LUA_TNIL || (key_type == LUA_TNUMBER &&
+                    lua_tonumber(L_, -1) != lua_tonumber(L_, -1))) {
+                return false; // nil or NaN
+            }
+            if (!read(depth + 1)) {
+                return false;
+            }
+            lua_rawset(L_, -3);
+        }
+    }
+};
+
+bool luawt_serialize(
+    lua_State* L,
+    int index,
+    std::string& out,
+    std::string& error
+) {
+    luawt_Writer writer(L, out);
+    if (!writer.write(index)) {
+        error = writer.error();
+        return false;
+    }
+    return true;
+}
+
+std::string luawt_checkSerialized(lua_State* L, int index) {
+    std::string out, error;
+    if (!luawt_serialize(L, index, out, error)) {
+        throw std::logic_error(error);
+    }
+    return out;
+}
+
+bool luawt_deserialize(lua_State* L, const char* data, size_t size) {
+    int top = lua_gettop(L);
+    luawt_Reader reader(L, data, size);
+    if (!reader.read(0) || !reader.finished()) {
+        lua_settop(L, top);
+        return false;
+    }
+    return true;
+}
+
+/** Converts a value to a string of compact binary format
+    Nil, booleans, numbers, strings and tables of them can be
+    serialized. Tables with cycles, functions, userdata and threads
+    can't. Metatables are not serialized.
+*/
+int luawt_Serialize_serialize(lua_State* L) {
+    luaL_checkany(L, 1);
+    std::string out = luawt_checkSerialized(L, 1);
+    lua_pushlstring(L, out.c_str(), out.size());
+    return 1;
+}
+
+/** Converts a string made by luawt.serialize back to a value */
+int luawt_Serialize_deserialize(lua_State* L) {
+    size_t size;
+    const char* data = luaL_checklstring(L, 1, &size);
+    if (!luawt_deserialize(L, data, size)) {
+        throw std::logic_error("LuaWt: malformed serialized value");
+    }
+    return 1;
+}
+
+static const luaL_Reg luawt_Serialize_functions[] = {
+    METHOD(Serialize, serialize),
+    METHOD(Serialize, deserialize),
+    {NULL, NULL},
+};
+
+void luawt_Serialize(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    my_setfuncs(L, luawt_Serialize_functions);
+    lua_pop(L, 1); // luawt
+}
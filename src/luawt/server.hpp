@@ -0,0 +1,201 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#ifndef SERVER_HPP_
+#define SERVER_HPP_
+
+/* Declarations shared by modules which exist only in luawt
+   (not in luawtest), because they need a running WServer.
+*/
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "boost-xtime.hpp"
+#include <Wt/WResource>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+
+/* Compiled code of an entry point. Sessions are created from
+   the current version; reload() replaces it atomically while
+   existing sessions keep running the code they started with.
+*/
+class luawt_AppCode {
+public:
+    luawt_AppCode(const std::string& bytecode):
+        bytecode_(new std::string(bytecode)), version_(1) {
+    }
+
+    boost::shared_ptr<const std::string> get() const {
+        boost::mutex::scoped_lock lock(mutex_);
+        return bytecode_;
+    }
+
+    int set(const std::string& bytecode) {
+        boost::shared_ptr<const std::string> b(new std::string(bytecode));
+        boost::mutex::scoped_lock lock(mutex_);
+        bytecode_ = b;
+        version_ += 1;
+        return version_;
+    }
+
+private:
+    mutable boost::mutex mutex_;
+    boost::shared_ptr<const std::string> bytecode_;
+    int version_;
+};
+
+typedef boost::shared_ptr<luawt_AppCode> AppCodePtr;
+
+/* Limits of session creation. 0 means no limit. */
+struct luawt_AdmissionOptions {
+    /* Sessions being created at the same time. */
+    int max_bootstraps;
+    /* Live sessions. */
+    int max_sessions;
+    /* Sessions per second per client address and burst size. */
+    double ip_rate;
+    double ip_burst;
+    /* Reload interval of the busy page, seconds. */
+    int busy_refresh;
+};
+
+/* Admission control of session creation, shared by all entry
+   points of a server. See admission.cpp.
+*/
+class luawt_Admission {
+public:
+    luawt_Admission(const luawt_AdmissionOptions& options);
+
+    bool enabled() const;
+
+    /* Takes a bootstrap slot without waiting.
+       Returns false if the session must not be created.
+       If true is returned, leave() must be called after creation.
+    */
+    bool enter(const std::string& ip);
+
+    void leave();
+
+    /* Cheap page asking the client to come back later. */
+    WApplication* busyApplication(const WEnvironment& env);
+
+private:
+    struct Bucket {
+        double tokens;
+        long long time;
+    };
+
+    typedef std::map<std::string, Bucket> Buckets;
+
+    luawt_AdmissionOptions options_;
+    boost::mutex mutex_;
+    int bootstraps_;
+    Buckets buckets_;
+    long long last_prune_;
+
+    bool takeToken(const std::string& ip, long long now);
+};
+
+typedef boost::shared_ptr<luawt_Admission> AdmissionPtr;
+
+/* Lua states shared by sessions of a server (see states.cpp). */
+class luawt_StatePool {
+public:
+    luawt_StatePool(
+        void* shared,
+        int size,
+        const luawt_AppOptions& options
+    );
+
+    ~luawt_StatePool();
+
+    /* Returns the state with the fewest sessions. */
+    luawt_SharedState* choose();
+
+private:
+    std::vector<luawt_SharedState*> states_;
+};
+
+typedef boost::shared_ptr<luawt_StatePool> StatePoolPtr;
+
+/* Sets globals of the function at the top of the stack to
+   the globals of the session: a table in its registry which falls
+   back to the globals of the shared state.
+*/
+void luawt_setSessionEnv(lua_State* L, MyApplication* app);
+
+/* Userdata of luawt_WServer. */
+struct luawt_Server {
+    /* Resources must outlive the server, so they are declared
+       before it: members are destroyed in reverse order.
+    */
+    std::vector<boost::shared_ptr<WResource> > resources;
+    /* Deployment path ("" for the default entry point) -> code. */
+    std::map<std::string, AppCodePtr> apps;
+    AdmissionPtr admission;
+    luawt_AppOptions app_options;
+    /* Empty unless option shared_states is set. Sessions use
+       the states, so they are destroyed after the server.
+    */
+    StatePoolPtr states;
+    WServer server;
+    /* Generated wt_config.xml, removed in __gc. */
+    std::string config_file;
+    /* Reference to the copy of options. */
+    int options_ref;
+    bool started;
+};
+
+luawt_Server* luawt_checkServer(lua_State* L, int index);
+
+/* Creates resource which calls a Lua function in a Lua state
+   of the worker thread. If is_chunk, code returns the function,
+   otherwise code is the function itself (bytecode).
+*/
+WResource* luawt_makeLuaResource(
+    void* shared,
+    const std::string& code,
+    bool is_chunk
+);
+
+struct luawt_StaticOptions {
+    /* Directory with the files. */
+    std::string dir;
+    /* Value of max-age in Cache-Control, seconds. */
+    int max_age;
+    /* Larger files are served but not kept in memory. */
+    size_t max_file_size;
+    /* Load all files on creation rather than on first request. */
+    bool preload;
+    /* Keep gzipped copies of compressible files. */
+    bool gzip;
+};
+
+/* Creates resource which serves files from memory.
+   See static.cpp.
+*/
+WResource* luawt_makeStaticResource(const luawt_StaticOptions& options);
+
+/* Runs tasks posted by luawt.main.post in state L until SIGINT,
+   SIGTERM, SIGQUIT or SIGHUP is received (the signal is returned)
+   or luawt_quitMain() is called (0 is returned).
+*/
+int luawt_runMain(lua_State* L, WServer& server);
+
+void luawt_quitMain();
+
+/* Stops and joins threads of luawt.jobs, dropping queued jobs.
+   The next job starts a new pool.
+*/
+void luawt_stopJobs();
+
+#endif
@@ -0,0 +1,63 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "boost-xtime.hpp"
+#include <boost/thread/mutex.hpp>
+
+#include "globals.hpp"
+
+/* IDs of sessions which have registered handlers of luawt.post.
+   It is in the common sources, since sessions of luawtest
+   hibernate too (see hibernate.cpp); the handlers are in post.cpp.
+*/
+class luawt_SessionRegistry {
+public:
+    void add(const std::string& id) {
+        boost::mutex::scoped_lock lock(mutex_);
+        ids_.insert(id);
+    }
+
+    void remove(const std::string& id) {
+        boost::mutex::scoped_lock lock(mutex_);
+        ids_.erase(id);
+    }
+
+    bool has(const std::string& id) {
+        boost::mutex::scoped_lock lock(mutex_);
+        return ids_.find(id) != ids_.end();
+    }
+
+    std::vector<std::string> all() {
+        boost::mutex::scoped_lock lock(mutex_);
+        return std::vector<std::string>(ids_.begin(), ids_.end());
+    }
+
+private:
+    boost::mutex mutex_;
+    std::set<std::string> ids_;
+};
+
+static luawt_SessionRegistry luawt_sessions;
+
+void luawt_registerPostTarget(const std::string& id) {
+    luawt_sessions.add(id);
+}
+
+void luawt_unregisterPostTarget(const std::string& id) {
+    luawt_sessions.remove(id);
+}
+
+bool luawt_isPostTarget(const std::string& id) {
+    return luawt_sessions.has(id);
+}
+
+std::vector<std::string> luawt_postTargets() {
+    return luawt_sessions.all();
+}
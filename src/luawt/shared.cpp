@@ -6,32 +6,134 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "boost-xtime.hpp"
 #include <boost/thread/mutex.hpp>
 
 #include "globals.hpp"
+#include "metrics.hpp"
+#include "shared.hpp"
 
-typedef std::string Str;
 typedef std::map<Str, Str> Map;
 typedef Map::const_iterator It;
 
-struct ProtectedMap {
-    Map shared;
-    boost::mutex mtx;
+/* Process-local storage. */
+class ProtectedMap : public SharedStore {
+public:
+    bool get(const Str& key, Str& value) {
+        luawt_TimedLock lock(mtx_);
+        It iterator = shared_.find(key);
+        if (iterator == shared_.end()) {
+            return false;
+        }
+        value = iterator->second;
+        return true;
+    }
+
+    void set(const Str& key, const Str& value) {
+        luawt_TimedLock lock(mtx_);
+        shared_[key] = value;
+    }
+
+    void remove(const Str& key) {
+        luawt_TimedLock lock(mtx_);
+        shared_.erase(key);
+    }
+
+    void getMany(
+        const Strs& keys,
+        Strs& values,
+        std::vector<bool>& found
+    ) {
+        values.resize(keys.size());
+        found.assign(keys.size(), false);
+        luawt_TimedLock lock(mtx_);
+        for (size_t i = 0; i < keys.size(); i++) {
+            It iterator = shared_.find(keys[i]);
+            if (iterator != shared_.end()) {
+                values[i] = iterator->second;
+                found[i] = true;
+            }
+        }
+    }
+
+    void setMany(const Pairs& assigned, const Strs& removed) {
+        luawt_TimedLock lock(mtx_);
+        for (size_t i = 0; i < assigned.size(); i++) {
+            shared_[assigned[i].first] = assigned[i].second;
+        }
+        for (size_t i = 0; i < removed.size(); i++) {
+            shared_.erase(removed[i]);
+        }
+    }
+
+    void scan(const Str& prefix, Pairs& pairs) {
+        luawt_TimedLock lock(mtx_);
+        It iterator = shared_.lower_bound(prefix);
+        while (iterator != shared_.end() && luawt_hasPrefix(
+                    iterator->first.c_str(),
+                    iterator->first.size(),
+                    prefix)) {
+            pairs.push_back(*iterator);
+            ++iterator;
+        }
+    }
+
+private:
+    Map shared_;
+    boost::mutex mtx_;
 };
 
+static SharedStore* luawt_getSharedStore(lua_State* L) {
+    return reinterpret_cast<SharedStore*>(luawt_getShared(L));
+}
+
+/* Values are stored with a tag: 's' is followed by a string
+   (strings and numbers are stored as strings), 'v' by a value made
+   by luawt_serialize (tables and true). Returns false if the key
+   must be removed (nil and false).
+*/
+static bool luawt_toSharedValue(lua_State* L, int index, Str& value) {
+    int type = lua_type(L, index);
+    if (type == LUA_TSTRING || type == LUA_TNUMBER) {
+        size_t len;
+        const char* str = lua_tolstring(L, index, &len);
+        value.reserve(len + 1);
+        value = 's';
+        value.append(str, len);
+        return true;
+    }
+    if (!lua_toboolean(L, index)) {
+        return false;
+    }
+    value = 'v';
+    std::string error;
+    if (!luawt_serialize(L, index, value, error)) {
+        throw std::logic_error(error);
+    }
+    return true;
+}
+
+static void luawt_pushSharedValue(lua_State* L, const Str& value) {
+    if (value.empty()) {
+        lua_pushnil(L);
+    } else if (value[0] == 'v') {
+        if (!luawt_deserialize(L, value.c_str() + 1, value.size() - 1)) {
+            lua_pushnil(L);
+        }
+    } else {
+        lua_pushlstring(L, value.c_str() + 1, value.size() - 1);
+    }
+}
+
 int luawt_Shared_index(lua_State* L) {
-    ProtectedMap* pm = reinterpret_cast<ProtectedMap*>(
-            luawt_getShared(L)
-        );
-    boost::mutex::scoped_lock lock(pm->mtx);
     size_t key_len;
     const char* key = luaL_checklstring(L, 2, &key_len);
-    It iterator = pm->shared.find(Str(key, key_len));
-    if (iterator != pm->shared.end()) {
-        const Str& value = iterator->second;
-        lua_pushlstring(L, value.c_str(), value.size());
+    Str value;
+    if (luawt_getSharedStore(L)->get(Str(key, key_len), value)) {
+        luawt_pushSharedValue(L, value);
     } else {
         lua_pushnil(L);
     }
@@ -39,33 +141,116 @@ int luawt_Shared_index(lua_State* L) {
 }
 
 int luawt_Shared_newindex(lua_State* L) {
-    ProtectedMap* pm = reinterpret_cast<ProtectedMap*>(
-            luawt_getShared(L)
-        );
-    boost::mutex::scoped_lock lock(pm->mtx);
-    size_t key_len, value_len;
+    size_t key_len;
     const char* key = luaL_checklstring(L, 2, &key_len);
-    const char* value = lua_tolstring(L, 3, &value_len);
-    if (value == 0) {
-        // remove key
-        pm->shared.erase(Str(key, key_len));
+    Str value;
+    bool assigned = luawt_toSharedValue(L, 3, value);
+    SharedStore* store = luawt_getSharedStore(L);
+    if (!assigned) {
+        store->remove(Str(key, key_len));
     } else {
-        pm->shared[Str(key, key_len)] = Str(value, value_len);
+        store->set(Str(key, key_len), value);
     }
     return 0;
 }
 
+/* Bulk operations. Arguments are converted before the store is
+   locked and results are pushed after it is unlocked, so Lua errors
+   can't leave the store locked and the lock is taken only once.
+*/
+
+int luawt_Shared_getMany(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    int keys_n = my_rawlen(L, 1);
+    Strs keys;
+    keys.reserve(keys_n);
+    for (int i = 1; i <= keys_n; i++) {
+        lua_rawgeti(L, 1, i);
+        size_t key_len;
+        const char* key = lua_tolstring(L, -1, &key_len);
+        if (key == 0) {
+            return luaL_error(L, "Keys of Shared must be strings");
+        }
+        keys.push_back(Str(key, key_len));
+        lua_pop(L, 1); // key
+    }
+    Strs values;
+    std::vector<bool> found;
+    luawt_getSharedStore(L)->getMany(keys, values, found);
+    lua_createtable(L, 0, keys_n);
+    for (int i = 0; i < keys_n; i++) {
+        if (found[i]) {
+            lua_pushlstring(L, keys[i].c_str(), keys[i].size());
+            luawt_pushSharedValue(L, values[i]);
+            lua_rawset(L, -3);
+        }
+    }
+    return 1;
+}
+
+int luawt_Shared_setMany(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    Pairs assigned;
+    Strs removed;
+    lua_pushnil(L);
+    while (lua_next(L, 1) != 0) {
+        if (lua_type(L, -2) != LUA_TSTRING) {
+            return luaL_error(L, "Keys of Shared must be strings");
+        }
+        size_t key_len;
+        const char* key = lua_tolstring(L, -2, &key_len);
+        Str value;
+        if (!luawt_toSharedValue(L, -1, value)) {
+            // Like in __newindex, false removes the key.
+            // Use it, since nil can't be stored in a table.
+            removed.push_back(Str(key, key_len));
+        } else {
+            assigned.push_back(Pair(Str(key, key_len), value));
+        }
+        lua_pop(L, 1); // value
+    }
+    luawt_getSharedStore(L)->setMany(assigned, removed);
+    return 0;
+}
+
+/* Returns all the pairs whose keys start with the prefix. */
+int luawt_Shared_scan(lua_State* L) {
+    size_t prefix_len;
+    const char* prefix = luaL_checklstring(L, 1, &prefix_len);
+    Pairs pairs;
+    luawt_getSharedStore(L)->scan(Str(prefix, prefix_len), pairs);
+    lua_createtable(L, 0, pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++) {
+        const Pair& pair = pairs[i];
+        lua_pushlstring(L, pair.first.c_str(), pair.first.size());
+        luawt_pushSharedValue(L, pair.second);
+        lua_rawset(L, -3);
+    }
+    return 1;
+}
+
 static const luaL_Reg luawt_shared_functions[] = {
     MT_METHOD(Shared, index),
     MT_METHOD(Shared, newindex),
     {NULL, NULL},
 };
 
+/* Bulk functions live in luawt.SharedOps, not in Shared itself,
+   so every key of Shared (including "scan") is stored data.
+*/
+static const luaL_Reg luawt_shared_methods[] = {
+    METHOD(Shared, getMany),
+    METHOD(Shared, setMany),
+    METHOD(Shared, scan),
+    {NULL, NULL},
+};
+
 void luawt_Shared(lua_State* L) {
     lua_getfield(L, LUA_REGISTRYINDEX, "luawt_pm");
     if (lua_type(L, -1) == LUA_TNIL) {
         // FIXME memory leak
-        luawt_setShared(L, new ProtectedMap);
+        SharedStore* store = new ProtectedMap;
+        luawt_setShared(L, store);
     }
     lua_pop(L, 1); // registry["luawt_pm"]
     luaL_getmetatable(L, "luawt");
@@ -75,6 +260,9 @@ void luawt_Shared(lua_State* L) {
     my_setfuncs(L, luawt_shared_functions);
     lua_setmetatable(L, -2);
     lua_setfield(L, -2, "Shared");
+    lua_newtable(L); // SharedOps table
+    my_setfuncs(L, luawt_shared_methods);
+    lua_setfield(L, -2, "SharedOps");
     lua_pop(L, 1); // luawt
 }
 
@@ -0,0 +1,62 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#ifndef SHARED_HPP_
+#define SHARED_HPP_
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::string Str;
+typedef std::vector<Str> Strs;
+typedef std::pair<Str, Str> Pair;
+typedef std::vector<Pair> Pairs;
+
+/* Storage behind luawt.Shared. registry['luawt_pm'] points to
+   an instance of a descendant of this class.
+   Each method locks the storage exactly once.
+*/
+class SharedStore {
+public:
+    virtual ~SharedStore() {
+    }
+
+    /* Returns false if the key is absent. */
+    virtual bool get(const Str& key, Str& value) = 0;
+
+    virtual void set(const Str& key, const Str& value) = 0;
+
+    virtual void remove(const Str& key) = 0;
+
+    /* found[i] is true if keys[i] is present; then values[i]
+       is its value. Vectors are resized by the method.
+    */
+    virtual void getMany(
+        const Strs& keys,
+        Strs& values,
+        std::vector<bool>& found
+    ) = 0;
+
+    virtual void setMany(const Pairs& assigned, const Strs& removed) = 0;
+
+    /* Appends to pairs all the pairs whose keys start with prefix
+       in ascending order of keys.
+    */
+    virtual void scan(const Str& prefix, Pairs& pairs) = 0;
+};
+
+inline bool luawt_hasPrefix(
+    const char* str,
+    size_t str_len,
+    const Str& prefix
+) {
+    return str_len >= prefix.size() &&
+           memcmp(str, prefix.data(), prefix.size()) == 0;
+}
+
+#endif
@@ -0,0 +1,253 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <cerrno>
+#include <functional>
+#include <string>
+
+#include <pthread.h>
+
+#include "boost-xtime.hpp"
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "globals.hpp"
+#include "metrics.hpp"
+#include "shared.hpp"
+
+namespace bip = boost::interprocess;
+
+typedef bip::managed_shared_memory Segment;
+typedef Segment::segment_manager SegmentManager;
+typedef bip::allocator<char, SegmentManager> CharAllocator;
+typedef bip::basic_string<char, std::char_traits<char>, CharAllocator>
+ShmStr;
+typedef std::pair<const ShmStr, ShmStr> ShmPair;
+typedef bip::allocator<ShmPair, SegmentManager> PairAllocator;
+typedef bip::map<ShmStr, ShmStr, std::less<ShmStr>, PairAllocator>
+ShmMap;
+
+/* Lives inside the segment. The mutex is process-shared and robust:
+   if a process dies holding it, lockers fail instead of waiting
+   forever, and the segment must be removed.
+*/
+struct ShmData {
+    ShmData(const PairAllocator& allocator):
+        map(std::less<ShmStr>(), allocator) {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+#endif
+        pthread_mutex_init(&mtx, &attr);
+        pthread_mutexattr_destroy(&attr);
+    }
+
+    pthread_mutex_t mtx;
+    ShmMap map;
+};
+
+class ShmLock {
+public:
+    ShmLock(pthread_mutex_t* mtx):
+        mtx_(mtx) {
+        long long start = luawt_now();
+        int status = pthread_mutex_lock(mtx_);
+        luawt_record(METRIC_SHARED_LOCK, luawt_now() - start);
+#ifdef __linux__
+        if (status == EOWNERDEAD) {
+            // The owner died, possibly in the middle of rebalancing
+            // the map, so it can't be trusted. Unlocking the mutex
+            // without pthread_mutex_consistent makes it unrecoverable:
+            // all later lockers get ENOTRECOVERABLE and throw too.
+            pthread_mutex_unlock(mtx_);
+            throw std::runtime_error("LuaWt: a process died while "
+                                     "modifying shared memory, "
+                                     "remove the segment");
+        }
+#endif
+        if (status != 0) {
+            throw std::runtime_error("LuaWt: unable to lock "
+                                     "shared memory");
+        }
+    }
+
+    ~ShmLock() {
+        pthread_mutex_unlock(mtx_);
+    }
+
+private:
+    pthread_mutex_t* mtx_;
+};
+
+/* Storage shared by all the processes which open the segment
+   with the same name.
+*/
+class ShmStore : public SharedStore {
+public:
+    ShmStore(const char* name, size_t size):
+        segment_(bip::open_or_create, name, size),
+        allocator_(segment_.get_segment_manager()) {
+        data_ = segment_.find_or_construct<ShmData>("luawt_shared")(
+                    PairAllocator(segment_.get_segment_manager())
+                );
+    }
+
+    bool get(const Str& key, Str& value) {
+        ShmStr shm_key(key.data(), key.size(), allocator_);
+        ShmLock lock(&data_->mtx);
+        ShmMap::const_iterator it = data_->map.find(shm_key);
+        if (it == data_->map.end()) {
+            return false;
+        }
+        value.assign(it->second.data(), it->second.size());
+        return true;
+    }
+
+    void set(const Str& key, const Str& value) {
+        ShmLock lock(&data_->mtx);
+        setLocked(key, value);
+    }
+
+    void remove(const Str& key) {
+        ShmStr shm_key(key.data(), key.size(), allocator_);
+        ShmLock lock(&data_->mtx);
+        data_->map.erase(shm_key);
+    }
+
+    void getMany(
+        const Strs& keys,
+        Strs& values,
+        std::vector<bool>& found
+    ) {
+        values.resize(keys.size());
+        found.assign(keys.size(), false);
+        ShmStr shm_key(allocator_);
+        ShmLock lock(&data_->mtx);
+        for (size_t i = 0; i < keys.size(); i++) {
+            shm_key.assign(keys[i].data(), keys[i].size());
+            ShmMap::const_iterator it = data_->map.find(shm_key);
+            if (it != data_->map.end()) {
+                values[i].assign(it->second.data(), it->second.size());
+                found[i] = true;
+            }
+        }
+    }
+
+    void setMany(const Pairs& assigned, const Strs& removed) {
+        ShmStr shm_key(allocator_);
+        ShmLock lock(&data_->mtx);
+        for (size_t i = 0; i < assigned.size(); i++) {
+            setLocked(assigned[i].first, assigned[i].second);
+        }
+        for (size_t i = 0; i < removed.size(); i++) {
+            shm_key.assign(removed[i].data(), removed[i].size());
+            data_->map.erase(shm_key);
+        }
+    }
+
+    void scan(const Str& prefix, Pairs& pairs) {
+        ShmStr shm_prefix(prefix.data(), prefix.size(), allocator_);
+        ShmLock lock(&data_->mtx);
+        ShmMap::const_iterator it = data_->map.lower_bound(shm_prefix);
+        while (it != data_->map.end() && luawt_hasPrefix(
+                    it->first.data(),
+                    it->first.size(),
+                    prefix)) {
+            pairs.push_back(Pair(
+                Str(it->first.data(), it->first.size()),
+                Str(it->second.data(), it->second.size())
+            ));
+            ++it;
+        }
+    }
+
+private:
+    Segment segment_;
+    CharAllocator allocator_;
+    ShmData* data_;
+
+    /* The mutex must be locked by the caller. */
+    void setLocked(const Str& key, const Str& value) {
+        ShmStr shm_key(key.data(), key.size(), allocator_);
+        ShmMap::iterator it = data_->map.find(shm_key);
+        if (it != data_->map.end()) {
+            it->second.assign(value.data(), value.size());
+        } else {
+            data_->map.insert(ShmPair(
+                shm_key,
+                ShmStr(value.data(), value.size(), allocator_)
+            ));
+        }
+    }
+};
+
+/** Switches luawt.Shared of this Lua state to shared memory
+    Argument 1 is the name of the segment (e.g., "luawt").
+    Argument 2 is the size of the segment in bytes, used if
+    the segment doesn't exist yet.
+    Must be called before luawt.WServer() to be used by sessions.
+*/
+int luawt_SharedMemory_open(lua_State* L) {
+    const char* name = luaL_checkstring(L, 1);
+    lint size = luaL_checkinteger(L, 2);
+    if (size <= 0) {
+        return luaL_error(L, "Size of shared memory must be positive");
+    }
+    // FIXME memory leak (like process-local storage)
+    SharedStore* store = new ShmStore(name, size);
+    lua_getfield(L, LUA_REGISTRYINDEX, "luawt_pm_local");
+    if (lua_type(L, -1) == LUA_TNIL) {
+        lua_pushlightuserdata(L, luawt_getShared(L));
+        lua_setfield(L, LUA_REGISTRYINDEX, "luawt_pm_local");
+    }
+    lua_pop(L, 1); // registry["luawt_pm_local"]
+    luawt_setShared(L, store);
+    return 0;
+}
+
+/** Switches luawt.Shared of this Lua state back to
+    process-local storage
+    Servers started after open() keep using shared memory.
+*/
+int luawt_SharedMemory_close(lua_State* L) {
+    lua_getfield(L, LUA_REGISTRYINDEX, "luawt_pm_local");
+    if (lua_type(L, -1) == LUA_TLIGHTUSERDATA) {
+        luawt_setShared(L, lua_touserdata(L, -1));
+    }
+    lua_pop(L, 1); // registry["luawt_pm_local"]
+    return 0;
+}
+
+/** Removes the segment from the system
+    Processes which have opened it keep using it.
+*/
+int luawt_SharedMemory_remove(lua_State* L) {
+    const char* name = luaL_checkstring(L, 1);
+    bool removed = bip::shared_memory_object::remove(name);
+    lua_pushboolean(L, removed);
+    return 1;
+}
+
+static const luaL_Reg luawt_SharedMemory_functions[] = {
+    METHOD(SharedMemory, open),
+    METHOD(SharedMemory, close),
+    METHOD(SharedMemory, remove),
+    {NULL, NULL},
+};
+
+void luawt_SharedMemory(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    lua_newtable(L); // SharedMemory table
+    my_setfuncs(L, luawt_SharedMemory_functions);
+    lua_setfield(L, -2, "SharedMemory");
+    lua_pop(L, 1); // luawt
+}
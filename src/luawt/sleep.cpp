@@ -0,0 +1,56 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <string>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <Wt/WIOService>
+#include <Wt/WServer>
+
+#include "globals.hpp"
+#include "server.hpp"
+
+static void luawt_resumeSleeping(lua_State* co) {
+    MyApplication::instance()->endAsync();
+    luawt_resumeSlot(co, 0);
+}
+
+/* Runs on a thread of WIOService, outside of the session. */
+static void luawt_wakeUp(const std::string& session_id, lua_State* co) {
+    WServer::instance()->post(
+        session_id,
+        boost::bind(luawt_resumeSleeping, co)
+    );
+}
+
+/** Suspends the slot for the number of seconds
+    Must be called from a slot. The worker thread is released
+    while the slot sleeps; rendering of the session waits for it.
+*/
+int luawt_sleep(lua_State* L) {
+    lua_Number seconds = luaL_checknumber(L, 1);
+    if (!luawt_canSuspend(L)) {
+        throw std::logic_error("LuaWt: luawt.sleep must be called "
+                               "from a slot");
+    }
+    MyApplication* app = MyApplication::instance();
+    app->beginAsync();
+    int ms = seconds > 0 ? static_cast<int>(seconds * 1000) : 0;
+    WServer::instance()->ioService().schedule(
+        ms,
+        boost::bind(luawt_wakeUp, app->sessionId(), L)
+    );
+    return luawt_suspend(L);
+}
+
+void luawt_Sleep(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    lua_pushcfunction(L, wrap<luawt_sleep>::func);
+    lua_setfield(L, -2, "sleep");
+    lua_pop(L, 1); // luawt
+}
@@ -0,0 +1,103 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include "globals.hpp"
+#include "server.hpp"
+
+/* A full state with standard libraries and luawt costs hundreds
+   of kilobytes. With option shared_states, sessions are spread over
+   a few states instead, so a mostly idle session costs only its
+   own data. Sessions of one state take turns (see luawt_StateLock),
+   so there should be about as many states as worker threads.
+*/
+
+static void luawt_closeStates(std::vector<luawt_SharedState*>& states) {
+    for (size_t i = 0; i < states.size(); i++) {
+        lua_close(states[i]->L);
+        delete states[i];
+    }
+    states.clear();
+}
+
+/* The states are made like states of sessions (luawt_newState),
+   so allocations are counted and the panic handler is set.
+   They have no memory limit: it would be shared by all sessions
+   of the state, so WServer rejects session_memory_limit together
+   with shared_states.
+*/
+luawt_StatePool::luawt_StatePool(
+    void* shared,
+    int size,
+    const luawt_AppOptions& options
+) {
+    for (int i = 0; i < size; i++) {
+        luawt_SharedState* state = new luawt_SharedState;
+        state->sessions = 0;
+        state->memory.used = 0;
+        state->memory.peak = 0;
+        state->memory.limit = 0;
+        state->L = luawt_newState(&state->memory);
+        if (!state->L) {
+            delete state;
+            luawt_closeStates(states_);
+            throw std::runtime_error("LuaWt: not enough memory "
+                                     "for shared Lua state");
+        }
+        states_.push_back(state);
+        luawt_configureGc(state->L, options);
+        if (luawt_cpcall(state->L, luawt_openSessionLibs,
+                         shared) != LUA_OK) {
+            const char* message = lua_tostring(state->L, -1);
+            std::string error = message ? message : "";
+            luawt_closeStates(states_);
+            throw std::runtime_error("LuaWt: unable to open shared "
+                                     "Lua state: " + error);
+        }
+        lua_settop(state->L, 0);
+    }
+}
+
+luawt_StatePool::~luawt_StatePool() {
+    luawt_closeStates(states_);
+}
+
+luawt_SharedState* luawt_StatePool::choose() {
+    luawt_SharedState* best = states_[0];
+    for (size_t i = 1; i < states_.size(); i++) {
+        if (states_[i]->sessions < best->sessions) {
+            best = states_[i];
+        }
+    }
+    return best;
+}
+
+void luawt_setSessionEnv(lua_State* L, MyApplication* app) {
+    app->pushRegistry(L);
+    lua_getfield(L, -1, "env");
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        lua_newtable(L); // env
+        lua_newtable(L); // metatable of env
+#if LUA_VERSION_NUM == 501
+        lua_pushvalue(L, LUA_GLOBALSINDEX);
+#else
+        lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+#endif
+        lua_setfield(L, -2, "__index");
+        lua_setmetatable(L, -2);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, "env");
+    }
+    lua_remove(L, -2); // registry of the session
+#if LUA_VERSION_NUM == 501
+    lua_setfenv(L, -2);
+#else
+    // the first upvalue of a main chunk is _ENV
+    if (!lua_setupvalue(L, -2, 1)) {
+        lua_pop(L, 1);
+    }
+#endif
+}
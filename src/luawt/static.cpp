@@ -0,0 +1,471 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+#include <zlib.h>
+
+#include "boost-xtime.hpp"
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <Wt/Http/Request>
+#include <Wt/Http/Response>
+#include <Wt/WLogger>
+#include <Wt/WResource>
+
+#include "globals.hpp"
+#include "server.hpp"
+
+/* File cached in memory. Immutable once created: a changed file
+   gets a new entry, so readers don't need the lock.
+*/
+struct luawt_Asset {
+    std::string data;
+    /* Empty if the file is not worth compressing. */
+    std::string gzipped;
+    std::string mime_type;
+    std::string etag;
+    /* ETag of the gzipped body, differs from etag of the data. */
+    std::string gzip_etag;
+    std::string last_modified;
+    time_t mtime;
+    off_t size;
+};
+
+typedef boost::shared_ptr<const luawt_Asset> AssetPtr;
+
+static const struct {
+    const char* extension;
+    const char* mime_type;
+    bool compress;
+} luawt_mime_types[] = {
+    {"css", "text/css", true},
+    {"js", "application/javascript", true},
+    {"json", "application/json", true},
+    {"html", "text/html", true},
+    {"htm", "text/html", true},
+    {"txt", "text/plain", true},
+    {"xml", "text/xml", true},
+    {"svg", "image/svg+xml", true},
+    {"png", "image/png", false},
+    {"gif", "image/gif", false},
+    {"jpg", "image/jpeg", false},
+    {"jpeg", "image/jpeg", false},
+    {"ico", "image/x-icon", false},
+    {"woff", "application/font-woff", false},
+    {NULL, "application/octet-stream", false},
+};
+
+static void luawt_findMimeType(
+    const std::string& path,
+    std::string& mime_type,
+    bool& compress
+) {
+    size_t dot = path.rfind('.');
+    std::string extension;
+    if (dot != std::string::npos && path.find('/', dot) == std::string::npos) {
+        extension = path.substr(dot + 1);
+    }
+    int i = 0;
+    for (; luawt_mime_types[i].extension; i++) {
+        if (extension == luawt_mime_types[i].extension) {
+            break;
+        }
+    }
+    mime_type = luawt_mime_types[i].mime_type;
+    compress = luawt_mime_types[i].compress;
+}
+
+static std::string luawt_httpDate(time_t t) {
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    char buffer[64];
+    strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return buffer;
+}
+
+/* Returns gzip stream or empty string on failure. */
+static std::string luawt_gzip(const std::string& data) {
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    // 15 + 16: maximum window, gzip header instead of zlib one
+    if (deflateInit2(&z, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16,
+                     8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return std::string();
+    }
+    std::string result(deflateBound(&z, data.size()), '\0');
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    z.avail_in = data.size();
+    z.next_out = reinterpret_cast<Bytef*>(&result[0]);
+    z.avail_out = result.size();
+    int status = deflate(&z, Z_FINISH);
+    result.resize(z.total_out);
+    deflateEnd(&z);
+    if (status != Z_STREAM_END) {
+        return std::string();
+    }
+    return result;
+}
+
+static bool luawt_readFile(const std::string& filename, std::string& data) {
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream out;
+    out << file.rdbuf();
+    data = out.str();
+    return true;
+}
+
+/* Rejects paths which could escape the directory. */
+static bool luawt_isSafePath(const std::string& path) {
+    if (path.empty() || path[0] != '/') {
+        return false;
+    }
+    size_t start = 1;
+    while (start <= path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        std::string part = path.substr(start, end - start);
+        if (part == ".." || part == "." || part.empty()) {
+            return false;
+        }
+        start = end + 1;
+    }
+    return path.find('\0') == std::string::npos;
+}
+
+/* Serves files of a directory from memory.
+   Files are loaded on first request (or on creation if
+   options.preload) and compressed once. Entries are dropped when
+   the files change: through inotify on Linux, otherwise each
+   request compares mtime and size of the file with the entry.
+   Responses carry ETag, Last-Modified and Cache-Control, and
+   conditional requests are answered with 304.
+*/
+class luawt_StaticResource : public WResource {
+public:
+    luawt_StaticResource(const luawt_StaticOptions& options):
+        options_(options), epoch_(0), inotify_fd_(-1), stopping_(false) {
+        while (options_.dir.size() > 1 &&
+                options_.dir[options_.dir.size() - 1] == '/') {
+            options_.dir.resize(options_.dir.size() - 1);
+        }
+#ifdef __linux__
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd_ != -1) {
+            watcher_.reset(new boost::thread(boost::bind(
+                &luawt_StaticResource::watch, this
+            )));
+        }
+#endif
+        if (options_.preload) {
+            preload("");
+        }
+    }
+
+    ~luawt_StaticResource() {
+        beingDeleted();
+        if (watcher_) {
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                stopping_ = true;
+            }
+            watcher_->join();
+        }
+        if (inotify_fd_ != -1) {
+            ::close(inotify_fd_);
+        }
+    }
+
+    void handleRequest(
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        std::string path = request.pathInfo();
+        if (!luawt_isSafePath(path)) {
+            response.setStatus(404);
+            return;
+        }
+        AssetPtr asset = find(path);
+        if (!asset) {
+            response.setStatus(404);
+            return;
+        }
+        std::string accept_encoding =
+            request.headerValue("Accept-Encoding");
+        bool gzipped = !asset->gzipped.empty() &&
+                       accept_encoding.find("gzip") != std::string::npos;
+        const std::string& etag = gzipped ? asset->gzip_etag : asset->etag;
+        response.addHeader("ETag", etag);
+        response.addHeader("Last-Modified", asset->last_modified);
+        std::ostringstream cache_control;
+        cache_control << "public, max-age=" << options_.max_age;
+        response.addHeader("Cache-Control", cache_control.str());
+        if (!asset->gzipped.empty()) {
+            response.addHeader("Vary", "Accept-Encoding");
+        }
+        std::string if_none_match = request.headerValue("If-None-Match");
+        std::string if_modified_since =
+            request.headerValue("If-Modified-Since");
+        bool not_modified = if_none_match.empty() ?
+                            if_modified_since == asset->last_modified :
+                            if_none_match.find(etag) != std::string::npos;
+        if (not_modified) {
+            response.setStatus(304);
+            return;
+        }
+        response.setMimeType(asset->mime_type);
+        const std::string* body = &asset->data;
+        if (gzipped) {
+            response.addHeader("Content-Encoding", "gzip");
+            body = &asset->gzipped;
+        }
+        response.setContentLength(body->size());
+        response.out().write(body->data(), body->size());
+    }
+
+private:
+    luawt_StaticOptions options_;
+    std::map<std::string, AssetPtr> assets_;
+    /* Watch descriptor -> directory relative to options_.dir. */
+    std::map<int, std::string> watched_dirs_;
+    /* Directories in watched_dirs_, to call inotify_add_watch once. */
+    std::set<std::string> watched_names_;
+    /* Incremented by the watcher when a file is invalidated.
+       load() publishes an entry only if the generation of its path
+       and epoch_ (incremented when all entries are dropped) are the
+       same as before reading the file.
+    */
+    std::map<std::string, unsigned> generations_;
+    unsigned epoch_;
+    boost::mutex mutex_;
+    int inotify_fd_;
+    bool stopping_;
+    std::auto_ptr<boost::thread> watcher_;
+
+    bool watching() const {
+        return inotify_fd_ != -1;
+    }
+
+    AssetPtr find(const std::string& path) {
+        AssetPtr asset;
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            std::map<std::string, AssetPtr>::const_iterator it =
+                assets_.find(path);
+            if (it != assets_.end()) {
+                asset = it->second;
+            }
+        }
+        if (asset && !watching()) {
+            struct stat st;
+            std::string filename = options_.dir + path;
+            if (stat(filename.c_str(), &st) != 0 ||
+                    st.st_mtime != asset->mtime ||
+                    st.st_size != asset->size) {
+                asset.reset();
+            }
+        }
+        if (!asset) {
+            asset = load(path);
+        }
+        return asset;
+    }
+
+    /* Reads and compresses the file outside the lock,
+       then publishes the entry. Returns empty pointer if the file
+       can't be served.
+    */
+    AssetPtr load(const std::string& path) {
+        std::string filename = options_.dir + path;
+        std::string dir = path.substr(0, path.rfind('/'));
+        // watch before reading, so a change made while reading
+        // drops the new entry instead of being lost
+        addWatch(dir);
+        unsigned generation, epoch;
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            generation = generations_[path];
+            epoch = epoch_;
+        }
+        struct stat st;
+        if (stat(filename.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+            return AssetPtr();
+        }
+        boost::shared_ptr<luawt_Asset> asset(new luawt_Asset);
+        if (!luawt_readFile(filename, asset->data)) {
+            return AssetPtr();
+        }
+        asset->mtime = st.st_mtime;
+        asset->size = st.st_size;
+        bool compress;
+        luawt_findMimeType(path, asset->mime_type, compress);
+        // files which are not cached are served as is: compressing
+        // them on every request would cost more than it saves
+        bool cached = asset->data.size() <= options_.max_file_size;
+        if (cached && compress && options_.gzip) {
+            asset->gzipped = luawt_gzip(asset->data);
+            if (asset->gzipped.size() >= asset->data.size()) {
+                asset->gzipped.clear();
+            }
+        }
+        std::ostringstream etag;
+        etag << '"' << std::hex << asset->size << '-' << asset->mtime;
+        asset->etag = etag.str() + '"';
+        asset->gzip_etag = etag.str() + "-gz\"";
+        asset->last_modified = luawt_httpDate(asset->mtime);
+        if (cached) {
+            boost::mutex::scoped_lock lock(mutex_);
+            // the file changed while it was being read
+            if (generations_[path] == generation && epoch_ == epoch) {
+                assets_[path] = asset;
+            }
+        }
+        return asset;
+    }
+
+    void preload(const std::string& dir) {
+        std::string dirname = options_.dir + dir;
+        DIR* d = opendir(dirname.c_str());
+        if (!d) {
+            return;
+        }
+        std::vector<std::string> subdirs;
+        while (struct dirent* entry = readdir(d)) {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            std::string path = dir + "/" + name;
+            struct stat st;
+            std::string filename = options_.dir + path;
+            if (stat(filename.c_str(), &st) != 0) {
+                continue;
+            }
+            if (S_ISDIR(st.st_mode)) {
+                subdirs.push_back(path);
+            } else if (S_ISREG(st.st_mode)) {
+                load(path);
+            }
+        }
+        closedir(d);
+        for (size_t i = 0; i < subdirs.size(); i++) {
+            preload(subdirs[i]);
+        }
+    }
+
+    void addWatch(const std::string& dir) {
+#ifdef __linux__
+        if (!watching()) {
+            return;
+        }
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            if (watched_names_.count(dir)) {
+                return;
+            }
+        }
+        std::string dirname = options_.dir + dir;
+        int wd = inotify_add_watch(
+                     inotify_fd_,
+                     dirname.c_str(),
+                     IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+                     IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                     IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF
+                 );
+        if (wd != -1) {
+            boost::mutex::scoped_lock lock(mutex_);
+            watched_dirs_[wd] = dir;
+            watched_names_.insert(dir);
+        }
+#endif
+    }
+
+#ifdef __linux__
+    /* Body of the watcher thread. Polls with a timeout to notice
+       that the resource is being destroyed.
+    */
+    void watch() {
+        std::vector<char> buffer(64 * 1024);
+        while (true) {
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                if (stopping_) {
+                    return;
+                }
+            }
+            struct pollfd pfd;
+            pfd.fd = inotify_fd_;
+            pfd.events = POLLIN;
+            if (poll(&pfd, 1, 200) <= 0) {
+                continue;
+            }
+            ssize_t n = ::read(inotify_fd_, &buffer[0], buffer.size());
+            if (n <= 0) {
+                continue;
+            }
+            boost::mutex::scoped_lock lock(mutex_);
+            for (ssize_t i = 0; i < n;) {
+                const struct inotify_event* event =
+                    reinterpret_cast<const inotify_event*>(&buffer[i]);
+                i += sizeof(struct inotify_event) + event->len;
+                if (event->mask & IN_Q_OVERFLOW) {
+                    // events were lost
+                    assets_.clear();
+                    epoch_ += 1;
+                    continue;
+                }
+                std::map<int, std::string>::iterator it =
+                    watched_dirs_.find(event->wd);
+                if (it == watched_dirs_.end()) {
+                    continue;
+                }
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF |
+                                   IN_IGNORED)) {
+                    // can't tell which files changed
+                    assets_.clear();
+                    epoch_ += 1;
+                    if (event->mask & IN_IGNORED) {
+                        watched_names_.erase(it->second);
+                        watched_dirs_.erase(it);
+                    }
+                    continue;
+                }
+                if (event->len > 0) {
+                    std::string path = it->second + "/" + event->name;
+                    assets_.erase(path);
+                    generations_[path] += 1;
+                }
+            }
+        }
+    }
+#endif
+};
+
+WResource* luawt_makeStaticResource(const luawt_StaticOptions& options) {
+    return new luawt_StaticResource(options);
+}
@@ -12,12 +12,54 @@ function test.sizeOf(table)
     return count
 end
 
-function test.socketRequest(port)
+function test.socketRequest(port, path)
     local http_client = require 'socket.http'
-    local data = http_client.request('http://127.0.0.1:' .. port)
+    local url = 'http://127.0.0.1:' .. port .. (path or '')
+    local data = http_client.request(url)
     return data
 end
 
+-- Returns command to run Lua interpreter which runs busted.
+function test.luaInterpreter()
+    local min_index = 0
+    while arg and arg[min_index - 1] do
+        min_index = min_index - 1
+    end
+    if min_index < 0 then
+        return arg[min_index]
+    end
+    return 'lua'
+end
+
+-- Returns shell command running Lua code in the background.
+function test.backgroundCommand(code)
+    local setup = ("package.path = %q; package.cpath = %q; "):format(
+        package.path,
+        package.cpath
+    )
+    return ("%s -e '%s' &"):format(
+        test.luaInterpreter(),
+        (setup .. code):gsub("'", "'\\''")
+    )
+end
+
+-- Runs Lua code in several processes concurrently and waits for them.
+-- Occurrences of %d in code are replaced with process number.
+function test.runProcesses(code, processes)
+    local commands = {}
+    for i = 1, processes do
+        local process_code = code:gsub('%%d', tostring(i))
+        table.insert(commands, test.backgroundCommand(process_code))
+    end
+    table.insert(commands, 'wait')
+    os.execute(table.concat(commands, '\n'))
+end
+
+-- Runs Lua code in another process without waiting for it.
+function test.runInBackground(code)
+    os.execute(test.backgroundCommand(code))
+end
+
 function test.baseConfig()
     local wt_config = os.tmpname()
     local file = io.open(wt_config, 'w')
@@ -46,20 +88,26 @@ function test.createServer(code, ip, port, wt_config)
 end
 
 function test.getData(code)
-    local ip = '127.0.0.1'
+    local luawt = require 'luawt'
     local port = 56789
-    local wt_config = test.baseConfig()
-    local server = test.createServer(code, ip, port, wt_config)
+    local server = luawt.WServer({
+        code = code,
+        ip = '127.0.0.1',
+        port = port,
+        progressive_bootstrap = true,
+    })
     server:start()
     os.execute("sleep 1")
     local data = test.socketRequest(port)
-    return server, wt_config, data
+    return server, nil, data
 end
 
 function test.clear(server, wt_config, force)
     os.execute("sleep 1")
     server:stop(force)
-    os.remove(wt_config)
+    if wt_config then
+        os.remove(wt_config)
+    end
 end
 
 function test.baseTest(code)
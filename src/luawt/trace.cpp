@@ -0,0 +1,241 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "boost-xtime.hpp"
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "globals.hpp"
+#include "trace.hpp"
+
+boost::atomic<bool> luawt_tracing(false);
+
+const size_t LUAWT_ID_SIZE = 48;
+
+/* Slot of the ring buffer. seq is odd while the slot is being
+   written, so readers can skip torn spans without locking.
+   A writer claims the slot by changing seq from even to odd, so
+   two writers which wrapped to the same slot never interleave.
+*/
+struct luawt_Span {
+    boost::atomic<unsigned> seq;
+    const char* name;
+    const void* fn;
+    long long start;
+    long long duration;
+    unsigned long thread;
+    char session[LUAWT_ID_SIZE];
+    char widget[LUAWT_ID_SIZE];
+};
+
+/* The buffer is allocated by the first start() and never freed,
+   so threads which saw it never write to freed memory.
+   The pointer is published with release after the slots and
+   the mask are written; writers and export load it with acquire.
+*/
+static boost::atomic<luawt_Span*> luawt_spans(0);
+static size_t luawt_spans_mask = 0;
+static boost::mutex luawt_spans_mutex;
+static boost::atomic<size_t> luawt_next_span(0);
+
+static void luawt_copyId(char* dst, const char* src) {
+    if (src) {
+        strncpy(dst, src, LUAWT_ID_SIZE - 1);
+        dst[LUAWT_ID_SIZE - 1] = '\0';
+    } else {
+        dst[0] = '\0';
+    }
+}
+
+void luawt_traceSpan(
+    const char* name,
+    const void* fn,
+    const char* widget_id,
+    long long start,
+    long long end
+) {
+    luawt_Span* spans = luawt_spans.load(boost::memory_order_acquire);
+    if (!spans) {
+        return;
+    }
+    size_t index = luawt_next_span.fetch_add(1, boost::memory_order_relaxed);
+    luawt_Span& span = spans[index & luawt_spans_mask];
+    unsigned seq = span.seq.load(boost::memory_order_relaxed);
+    do {
+        if (seq % 2 == 1) {
+            return; // another writer owns the slot, drop the span
+        }
+    } while (!span.seq.compare_exchange_weak(
+                 seq, seq + 1,
+                 boost::memory_order_acquire,
+                 boost::memory_order_relaxed
+             ));
+    span.name = name;
+    span.fn = fn;
+    span.start = start;
+    span.duration = end - start;
+    span.thread = static_cast<unsigned long>(pthread_self());
+    WApplication* app = WApplication::instance();
+    luawt_copyId(span.session, app ? app->sessionId().c_str() : 0);
+    luawt_copyId(span.widget, widget_id);
+    span.seq.fetch_add(1, boost::memory_order_release);
+}
+
+/* Name of the bound function, e.g. "luawt_WText_setText". */
+static std::string luawt_functionName(const void* fn) {
+    Dl_info info;
+    if (!dladdr(fn, &info) || !info.dli_sname) {
+        return "binding";
+    }
+    int status;
+    char* demangled = abi::__cxa_demangle(info.dli_sname, 0, 0, &status);
+    std::string name = (status == 0) ? demangled : info.dli_sname;
+    free(demangled);
+    size_t paren = name.find('(');
+    if (paren != std::string::npos) {
+        name.resize(paren);
+    }
+    return name;
+}
+
+static void luawt_writeJsonString(std::ostream& out, const char* str) {
+    out << '"';
+    for (const char* c = str; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char buffer[8];
+            sprintf(buffer, "\\u%04x", *c);
+            out << buffer;
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+/** Starts recording spans
+    Argument 1 is the capacity of the ring buffer (spans, rounded
+    up to a power of two), used only by the first call.
+    Spans are recorded for session creation, requests handled by
+    sessions, Lua slots and bound C functions.
+    Rendering has no span of its own: Wt renders the response
+    inside WApplication::notify, so it is part of "request".
+*/
+int luawt_Trace_start(lua_State* L) {
+    lint capacity = luaL_optinteger(L, 1, 65536);
+    if (capacity <= 0) {
+        return luaL_error(L, "Capacity of trace must be positive");
+    }
+    if (!luawt_spans.load(boost::memory_order_acquire)) {
+        boost::mutex::scoped_lock lock(luawt_spans_mutex);
+        if (!luawt_spans.load(boost::memory_order_relaxed)) {
+            size_t size = 1;
+            while (size < size_t(capacity)) {
+                size *= 2;
+            }
+            luawt_Span* spans = new luawt_Span[size];
+            for (size_t i = 0; i < size; i++) {
+                spans[i].seq.store(0, boost::memory_order_relaxed);
+            }
+            luawt_spans_mask = size - 1;
+            luawt_spans.store(spans, boost::memory_order_release);
+        }
+    }
+    luawt_tracing.store(true, boost::memory_order_relaxed);
+    return 0;
+}
+
+int luawt_Trace_stop(lua_State* L) {
+    luawt_tracing.store(false, boost::memory_order_relaxed);
+    return 0;
+}
+
+/** Returns recorded spans in Chrome trace JSON format
+    The result can be opened in about://tracing or Perfetto.
+    If argument 1 is true, the buffer is cleared.
+*/
+int luawt_Trace_export(lua_State* L) {
+    bool clear = lua_toboolean(L, 1);
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    luawt_Span* spans = luawt_spans.load(boost::memory_order_acquire);
+    size_t size = spans ? luawt_spans_mask + 1 : 0;
+    int pid = getpid();
+    for (size_t i = 0; i < size; i++) {
+        luawt_Span& slot = spans[i];
+        unsigned seq = slot.seq.load(boost::memory_order_acquire);
+        if (seq == 0 || seq % 2 == 1) {
+            continue;
+        }
+        luawt_Span span;
+        span.name = slot.name;
+        span.fn = slot.fn;
+        span.start = slot.start;
+        span.duration = slot.duration;
+        span.thread = slot.thread;
+        memcpy(span.session, slot.session, sizeof(span.session));
+        memcpy(span.widget, slot.widget, sizeof(span.widget));
+        boost::atomic_thread_fence(boost::memory_order_acquire);
+        if (slot.seq.load(boost::memory_order_relaxed) != seq) {
+            continue; // rewritten while copying
+        }
+        if (clear) {
+            slot.seq.compare_exchange_strong(seq, 0);
+        }
+        if (!first) {
+            out << ",";
+        }
+        first = false;
+        std::string name = span.fn ?
+                           luawt_functionName(span.fn) : span.name;
+        out << "\n{\"name\":";
+        luawt_writeJsonString(out, name.c_str());
+        out << ",\"cat\":";
+        luawt_writeJsonString(out, span.name);
+        out << ",\"ph\":\"X\",\"ts\":" << span.start
+            << ",\"dur\":" << span.duration
+            << ",\"pid\":" << pid
+            << ",\"tid\":" << span.thread
+            << ",\"args\":{\"session\":";
+        luawt_writeJsonString(out, span.session);
+        out << ",\"widget\":";
+        luawt_writeJsonString(out, span.widget);
+        out << "}}";
+    }
+    out << "\n]}\n";
+    std::string json = out.str();
+    lua_pushlstring(L, json.c_str(), json.size());
+    return 1;
+}
+
+static const luaL_Reg luawt_Trace_functions[] = {
+    METHOD(Trace, start),
+    METHOD(Trace, stop),
+    METHOD(Trace, export),
+    {NULL, NULL},
+};
+
+void luawt_Trace(lua_State* L) {
+    luaL_getmetatable(L, "luawt");
+    assert(lua_type(L, -1) == LUA_TTABLE);
+    lua_newtable(L); // Trace table
+    my_setfuncs(L, luawt_Trace_functions);
+    lua_setfield(L, -2, "Trace");
+    lua_pop(L, 1); // luawt
+}
@@ -0,0 +1,60 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#ifndef TRACE_HPP_
+#define TRACE_HPP_
+
+#include "boost-xtime.hpp"
+#include <boost/atomic.hpp>
+
+#include "metrics.hpp"
+
+/* Tracing records spans into a process-wide ring buffer.
+   It is off by default; then a span costs one relaxed load.
+   See luawt.Trace in trace.cpp.
+*/
+extern boost::atomic<bool> luawt_tracing;
+
+inline bool luawt_isTracing() {
+    return luawt_tracing.load(boost::memory_order_relaxed);
+}
+
+/* name must be a string literal. fn is the bound C function
+   for spans of bindings (resolved to its name on export).
+*/
+void luawt_traceSpan(
+    const char* name,
+    const void* fn,
+    const char* widget_id,
+    long long start,
+    long long end
+);
+
+class luawt_TraceSpan {
+public:
+    luawt_TraceSpan(
+        const char* name,
+        const void* fn = 0,
+        const char* widget_id = 0
+    ):
+        name_(name), fn_(fn), widget_id_(widget_id),
+        start_(luawt_isTracing() ? luawt_now() : 0) {
+    }
+
+    ~luawt_TraceSpan() {
+        if (start_) {
+            luawt_traceSpan(name_, fn_, widget_id_, start_, luawt_now());
+        }
+    }
+
+private:
+    const char* name_;
+    const void* fn_;
+    const char* widget_id_;
+    long long start_;
+};
+
+#endif
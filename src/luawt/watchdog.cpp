@@ -0,0 +1,97 @@
+/* luawt, Lua bindings for Wt
+ * Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+ *
+ * See the LICENSE file for terms of use.
+ */
+
+#include <algorithm>
+
+#include "boost-xtime.hpp"
+#include <boost/thread/tss.hpp>
+
+#include "globals.hpp"
+
+/* A handler runs with a count hook which is called every
+   WATCHDOG_INTERVAL instructions, so the budget costs nothing
+   between the calls. The hook raises an error when the budget is
+   exceeded; it is raised again on each later call, so the handler
+   can't swallow it with pcall for long. Time spent in C functions
+   (e.g. os.execute) is not interrupted, it is noticed by the next
+   call of the hook.
+   The hook is installed in the thread passed to the watchdog and
+   stays there: it does nothing while no watchdog is active, and
+   coroutines created later inherit it, so a coroutine created
+   outside of a handler is limited when a handler resumes it.
+   Threads created before the hook was installed get it when they
+   are passed to a watchdog (resumed slots).
+*/
+
+enum {
+    WATCHDOG_INTERVAL = 1000,
+};
+
+static void luawt_noCleanup(luawt_Watchdog*) {
+}
+
+/* Active watchdog of the thread. Wt runs one handler per thread
+   at a time, and the hook has no user data, so it is found here.
+*/
+static boost::thread_specific_ptr<luawt_Watchdog> luawt_watchdog(
+    luawt_noCleanup
+);
+
+static void luawt_watchdogHook(lua_State* L, lua_Debug*) {
+    luawt_Watchdog* watchdog = luawt_watchdog.get();
+    if (watchdog && watchdog->exceeded()) {
+        luaL_error(L, "LuaWt: handler exceeded its CPU budget");
+    }
+}
+
+luawt_Watchdog::luawt_Watchdog(
+    lua_State* L,
+    const luawt_AppOptions& options
+):
+    active_(false), interval_(WATCHDOG_INTERVAL),
+    instructions_left_(options.handler_instructions),
+    deadline_(0), counted_(false) {
+    if (!options.handler_instructions && !options.handler_timeout_ms) {
+        return;
+    }
+    if (instructions_left_) {
+        interval_ = std::min<long long>(interval_, instructions_left_);
+    }
+    lua_sethook(L, luawt_watchdogHook, LUA_MASKCOUNT, interval_);
+    if (luawt_watchdog.get()) {
+        return; // nested handler
+    }
+    if (options.handler_timeout_ms) {
+        deadline_ = luawt_now() + options.handler_timeout_ms * 1000;
+    }
+    active_ = true;
+    luawt_watchdog.reset(this);
+}
+
+luawt_Watchdog::~luawt_Watchdog() {
+    if (active_) {
+        luawt_watchdog.release();
+    }
+}
+
+bool luawt_Watchdog::exceeded() {
+    bool result = false;
+    if (instructions_left_) {
+        instructions_left_ -= interval_;
+        result = (instructions_left_ <= 0);
+        if (result) {
+            instructions_left_ = -1; // don't wrap to "no limit"
+        }
+    }
+    if (deadline_ && luawt_now() > deadline_) {
+        result = true;
+    }
+    if (result && !counted_) {
+        luawt_count(COUNTER_HANDLERS_ABORTED);
+        counted_ = true;
+    }
+    return result;
+}
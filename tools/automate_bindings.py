@@ -38,7 +38,30 @@ PROBLEMATIC_TO_BUILTIN_CONVERSIONS = {
     'Wt::WLength' : ('value', 'double'),
 }
 
+# Strings are read from Lua with their length and as UTF-8
+# (see luawt_toStdString and luawt_toWString in globals.hpp).
+STRING_FROM_LUA_CONVERSIONS = {
+    'std::string' : 'luawt_toStdString(L, %d)',
+    'Wt::WString' : 'luawt_toWString(L, %d)',
+    'Wt::WLink' : 'Wt::WLink(luawt_toStdString(L, %d))',
+}
+
+# Types converted by luawt_Arg and luawt_Result (see marshal.hpp).
+MARSHAL_TYPES = set([
+    'int',
+    'bool',
+    'double',
+    'char const *',
+    'std::string',
+    'Wt::WString',
+    'Wt::WLink',
+    'Wt::WLength',
+])
+
+MARSHAL_MAX_ARGS = 4
+
 XML_CACHE = 'src/luawt/xml'
+DEPENDENCIES = 'src/luawt/dependencies.lua'
 INCLUDE_WT = '/usr/include/Wt'
 
 # =============================================================================
@@ -475,6 +498,7 @@ INCLUDES_TEMPLATE = r'''
 
 #include "enums.hpp"
 #include "globals.hpp"
+#include "marshal.hpp"
 
 '''
 
@@ -563,6 +587,9 @@ def getBuiltinTypeArgument(options):
     get_builtin_arg_template = r'''
     %(argument_type)s %(argument_name)s = %(func)s(L, %(index)s);
     '''
+    get_string_arg_template = r'''
+    %(string_type)s %(argument_name)s = %(convert)s;
+    '''
     get_enum_arg_template = r'''
     %(argument_type)s %(argument_name)s = %(func)s(luawt_getEnum(
         L,
@@ -576,6 +603,12 @@ def getBuiltinTypeArgument(options):
         PROBLEMATIC_TO_BUILTIN_CONVERSIONS,
         str(options['argument_type']),
     )
+    if problematic_type in STRING_FROM_LUA_CONVERSIONS:
+        options['string_type'] = problematic_type
+        options['convert'] = (
+            STRING_FROM_LUA_CONVERSIONS[problematic_type] % options['index']
+        )
+        return get_string_arg_template.lstrip() % options
     if problematic_type:
         options['raw_type'] = getBuiltinType(problematic_type)
         code = get_problematic_arg_template.lstrip() % options
@@ -628,7 +661,7 @@ def addWidgetToContainer(module_name):
         delete l_result;
         throw std::logic_error("No WApplication when creating %s");
     }
-    app->root()->addWidget(l_result);
+    luawt_defaultParent(app)->addWidget(l_result);
     '''
     return frame % module_name
 
@@ -652,6 +685,11 @@ RETURN_CALLS_TEMPLATE = r'''
     return 1;
 '''
 
+RETURN_STRING_TEMPLATE = r'''
+    luawt_pushString(L, l_result%s);
+    return 1;
+'''
+
 RETURN_ENUM_TEMPLATE = r'''
     luawt_returnEnum(L, %s, %s, l_result, "%s");
     return 1;
@@ -691,6 +729,9 @@ def returnValue(return_type):
         )
         if problematic_type:
             convert_f = getBuiltinTypeFromProblematic(problematic_type)
+            if convert_f.endswith('.c_str()'):
+                # Push std::string with its length.
+                return RETURN_STRING_TEMPLATE % convert_f[:-len('.c_str()')]
         if return_type in GLOBAL_ENUMS_REGISTRY:
             # Enum.
             enum_name = GLOBAL_ENUMS_REGISTRY[return_type][0]
@@ -905,6 +946,16 @@ def generateConstructor(module_name, constructors):
         constructor_return_type,
     )
 
+# Defines luawt_<module>_<method> of methods bound by BIND_METHOD.
+def generateBoundMethods(bound, module_name):
+    BIND_TEMPLATE = 'BIND_METHOD(%s, %s)\n'
+    bind_code = []
+    for method_name in sorted(bound):
+        bind_code.append(BIND_TEMPLATE % (module_name, method_name))
+    if bind_code:
+        bind_code.append('\n')
+    return ''.join(bind_code)
+
 def generateSignals(signals, module_name):
     SIG_TEMPLATE = 'ADD_SIGNAL(%(name)s, %(module)s, %(event)s)\n'
     sig_code = []
@@ -1004,6 +1055,53 @@ def generateSetEnumsCalls(enum_names):
         body += call_template.rstrip() % enum_name.replace('::', '_')
     return SET_ENUMS_FUNC_TEMPLATE.lstrip() % body
 
+def isMarshalType(type_o, is_return):
+    type_s = str(type_o)
+    if type_s == 'char const *':
+        return not is_return
+    if pygccxml.declarations.is_pointer(type_o):
+        # Widget.
+        return not getBuiltinType(type_s)
+    clear_s = str(clearType(type_o))
+    if clear_s in GLOBAL_ENUMS_REGISTRY:
+        return False
+    if getBuiltinType(type_s):
+        return clear_s in MARSHAL_TYPES
+    # Widget passed by reference.
+    return not is_return
+
+# Check if the method can be bound by BIND_METHOD (see marshal.hpp):
+# single signature (&Klass::method must be unambiguous), no default
+# arguments and no enums. The method must be a non-static member
+# of the class itself, otherwise &Klass::method has another type.
+def isMarshalable(module_name, group):
+    if module_name == 'MyApplication':
+        # Methods of WApplication, self is MyApplication.
+        return False
+    if len(group) != 1:
+        return False
+    method = group[0]
+    if method.has_static or method.parent.name != module_name:
+        return False
+    if method.optional_args:
+        return False
+    if len(method.arguments) > MARSHAL_MAX_ARGS:
+        return False
+    same_name = method.parent.member_functions(
+        name=method.name,
+        recursive=False,
+        allow_empty=True,
+    )
+    if len(same_name) != 1:
+        return False
+    for arg in method.arguments:
+        if not isMarshalType(getArgType(arg), False):
+            return False
+    return_type = method.return_type
+    if str(return_type) == 'void':
+        return True
+    return isMarshalType(return_type, True)
+
 def generateModule(module_name, methods, base, constructors, signals):
     source = []
     includes = getIncludes(module_name, methods, constructors)
@@ -1015,7 +1113,11 @@ def generateModule(module_name, methods, base, constructors, signals):
         if method.name not in name2methods:
             name2methods[method.name] = []
         name2methods[method.name].append(method)
+    bound = set()
     for method_name, group in name2methods.items():
+        if isMarshalable(module_name, group):
+            bound.add(method_name)
+            continue
         return_type = group[0].return_type
         for method in group:
             assert method.return_type == return_type
@@ -1026,8 +1128,12 @@ def generateModule(module_name, methods, base, constructors, signals):
             makeArgsOverloads(group),
             return_type,
         ))
+    source.append(generateBoundMethods(bound, module_name))
     source.append(generateSignals(signals, module_name))
-    source.append(generateMethodsArray(module_name, methods + signals))
+    source.append(generateMethodsArray(
+        module_name,
+        methods + signals,
+    ))
     source.append(generateModuleFunc(
         module_name,
         base,
@@ -1193,6 +1299,10 @@ def bind(modules, module_only, blacklist, gen_enums=False):
                 # Is not abstract.
                 addTest(module_name, constructors_type)
             writeSourceToFile(module_name + '.cpp', source)
+            writeDependencies(
+                module_name,
+                getDependencies(methods, base),
+            )
         except Exception as e:
             if len(modules) == 1:
                 raise
@@ -1210,6 +1320,45 @@ def bind(modules, module_only, blacklist, gen_enums=False):
             True
         ))
 
+DEPENDENCIES_HEADER = r'''
+-- Generated by tools/automate_bindings.py, read by tools/prune.lua
+-- Base class and classes of widgets returned by methods of
+-- each module (they need metatables).
+
+return {
+'''
+
+# Returns classes needed by module: base class and classes of
+# widgets returned by methods.
+def getDependencies(methods, base):
+    dependencies = set()
+    if base != '0':
+        dependencies.add(base.name)
+    for method in methods:
+        return_type = str(method.return_type)
+        if return_type == 'void' or getBuiltinType(return_type):
+            continue
+        if return_type in GLOBAL_ENUMS_REGISTRY:
+            continue
+        class_name = str(clearType(method.return_type))
+        dependencies.add(class_name.replace('Wt::', ''))
+    return sorted(dependencies)
+
+# Replaces the entry of the module in dependencies.lua.
+def writeDependencies(module_name, dependencies):
+    entries = {}
+    if os.path.exists(DEPENDENCIES):
+        for line in readFile(DEPENDENCIES):
+            match = re.match(r'\s+(\w+) = \{(.*)\},$', line)
+            if match:
+                entries[match.group(1)] = match.group(2)
+    entries[module_name] = ', '.join("'%s'" % d for d in dependencies)
+    content = [DEPENDENCIES_HEADER.lstrip()]
+    for name in sorted(entries):
+        content.append('    %s = {%s},\n' % (name, entries[name]))
+    content.append('}\n')
+    writeToFile(DEPENDENCIES, ''.join(content))
+
 def collectMembers(path):
     if os.path.exists(XML_CACHE):
         shutil.rmtree(XML_CACHE)
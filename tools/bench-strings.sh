@@ -0,0 +1,33 @@
+#!/bin/bash
+
+# Counts heap allocations of WText:setText() and text() with large
+# strings. The loop is run N and 2*N times under valgrind, so
+# the difference divided by N excludes the startup.
+# Usage: SIZE=1000000 N=100 ./tools/bench-strings.sh
+
+set -ue
+
+SIZE=${SIZE:-1000000}
+N=${N:-100}
+
+run() {
+    valgrind lua -e "
+        local luawtest = require 'luawtest'
+        local env = luawtest.WTestEnvironment()
+        local app = luawtest.MyApplication(env)
+        local text = luawtest.WText(app:root())
+        text:setTextFormat('PlainText')
+        local str = ('x'):rep($SIZE)
+        for _ = 1, $1 do
+            text:setText(str)
+            assert(#text:text() == $SIZE)
+        end
+    " 2>&1 | sed -n 's/.*total heap usage: \([0-9,]*\) allocs, [0-9,]* frees, \([0-9,]*\) bytes.*/\1 \2/p' | tr -d ,
+}
+
+read allocs1 bytes1 <<< "$(run $N)"
+read allocs2 bytes2 <<< "$(run $((2 * N)))"
+
+echo "string of $SIZE bytes, per setText + text:"
+echo "allocations: $(( (allocs2 - allocs1) / N ))"
+echo "bytes: $(( (bytes2 - bytes1) / N ))"
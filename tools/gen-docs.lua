@@ -47,8 +47,12 @@ for _, c in ipairs(classes) do
     local mt = reg[mangled]
     if mt ~= nil then
         local methods = {}
-        for m in pairs(mt.__index) do
-            table.insert(methods, m)
+        local base = mt.__base and mt.__base.__index or {}
+        for m, f in pairs(mt.__index) do
+            -- __index includes inherited methods, list own ones
+            if base[m] ~= f then
+                table.insert(methods, m)
+            end
         end
         table.sort(methods)
         for _, m in ipairs(methods) do
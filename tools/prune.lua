@@ -0,0 +1,225 @@
+#!/usr/bin/env lua
+
+-- luawt, Lua bindings for Wt
+-- Copyright (c) 2015-2017 Pavel Dolgov and Boris Nagaev
+-- See the LICENSE file for terms of use.
+
+-- Generates a build of luawt with a subset of widget classes.
+--
+-- Usage: lua tools/prune.lua [--scan app.lua]... [Class]...
+--
+-- Classes are given by name (WPushButton) or found in Lua files
+-- passed with --scan. Base classes and classes returned by methods
+-- of the selected classes are added automatically, they are read
+-- from src/luawt/dependencies.lua written by automate_bindings.py.
+-- Writes src/luawt/pruned_modules.hpp (list of modules registered
+-- by init.cpp when LUAWT_PRUNED is defined) and
+-- luawt-pruned-0.0-1.rockspec, which compiles only the selected
+-- classes. Build it with luarocks make luawt-pruned-0.0-1.rockspec
+-- from the root of the repository.
+
+local SRC = 'src/luawt/'
+local ROCKSPEC = 'luawt-0.0-1.rockspec'
+local PRUNED_ROCKSPEC = 'luawt-pruned-0.0-1.rockspec'
+local PRUNED_MODULES = SRC .. 'pruned_modules.hpp'
+local DEPENDENCIES = SRC .. 'dependencies.lua'
+
+local function readFile(filename)
+    local f = assert(io.open(filename, 'rb'))
+    local content = f:read('*a')
+    f:close()
+    return content
+end
+
+local function writeFile(filename, content)
+    local f = assert(io.open(filename, 'wb'))
+    f:write(content)
+    f:close()
+end
+
+-- Returns widget modules in order of registration (base first).
+local function widgetModules()
+    local init = readFile(SRC .. 'init.cpp')
+    local widgets = init:match('#ifdef LUAWT_PRUNED\n.-#else\n(.-)#endif')
+    assert(widgets, 'unable to find list of widgets in init.cpp')
+    local modules = {}
+    for name in widgets:gmatch('MODULE%((%w+)%)') do
+        table.insert(modules, name)
+    end
+    return modules
+end
+
+-- Classes needed by each module: base class and classes
+-- of widgets returned by methods (they need metatables).
+local all_dependencies = assert(dofile(DEPENDENCIES))
+
+local function dependencies(name)
+    local result = all_dependencies[name]
+    assert(result, 'no dependencies of ' .. name .. ' in ' ..
+        DEPENDENCIES .. ', run tools/automate_bindings.py')
+    local copy = {}
+    for i, dep in ipairs(result) do
+        copy[i] = dep
+    end
+    return copy
+end
+
+local function scanFile(filename, is_module, selected)
+    local code = readFile(filename)
+    for name in code:gmatch('%f[%w_](W%u%w*)') do
+        if is_module[name] then
+            selected[name] = true
+        end
+    end
+end
+
+local function parseArgs(is_module)
+    local selected = {}
+    local i = 1
+    while i <= #arg do
+        if arg[i] == '--scan' then
+            scanFile(assert(arg[i + 1], '--scan needs a file'),
+                is_module, selected)
+            i = i + 2
+        else
+            assert(is_module[arg[i]], 'unknown class ' .. arg[i])
+            selected[arg[i]] = true
+            i = i + 1
+        end
+    end
+    return selected
+end
+
+-- Adds dependencies of selected classes and of MyApplication.
+local function closure(selected, is_module)
+    local queue = dependencies('MyApplication')
+    for name in pairs(selected) do
+        table.insert(queue, name)
+    end
+    local result = {}
+    while #queue > 0 do
+        local name = table.remove(queue)
+        if is_module[name] and not result[name] then
+            result[name] = true
+            for _, dep in ipairs(dependencies(name)) do
+                table.insert(queue, dep)
+            end
+        end
+    end
+    return result
+end
+
+local function loadRockspec(filename)
+    local env = {}
+    local code = readFile(filename)
+    local chunk
+    if setfenv then
+        chunk = assert(loadstring(code, filename))
+        setfenv(chunk, env)
+    else
+        chunk = assert(load(code, filename, 't', env))
+    end
+    chunk()
+    return env
+end
+
+local function isIdentifier(key)
+    return type(key) == 'string' and key:match('^[%a_][%w_]*$')
+end
+
+local function serialize(value, indent)
+    if type(value) ~= 'table' then
+        return string.format('%q', value)
+    end
+    local inner = indent .. '    '
+    local lines = {}
+    for _, item in ipairs(value) do
+        table.insert(lines, inner .. serialize(item, inner) .. ',')
+    end
+    local keys = {}
+    for key in pairs(value) do
+        if type(key) ~= 'number' then
+            table.insert(keys, key)
+        end
+    end
+    table.sort(keys)
+    for _, key in ipairs(keys) do
+        local key_str = isIdentifier(key) and key or
+            ('[%q]'):format(key)
+        table.insert(lines, ('%s%s = %s,'):format(
+            inner, key_str, serialize(value[key], inner)))
+    end
+    if #lines == 0 then
+        return '{}'
+    end
+    return '{\n' .. table.concat(lines, '\n') .. '\n' .. indent .. '}'
+end
+
+local function pruneSources(sources, is_module, kept)
+    local result = {}
+    for _, source in ipairs(sources) do
+        local name = source:match('^src/luawt/(%w+)%.cpp$')
+        if not (name and is_module[name] and not kept[name]) then
+            table.insert(result, source)
+        end
+    end
+    return result
+end
+
+local function writeRockspec(is_module, kept)
+    local rockspec = loadRockspec(ROCKSPEC)
+    rockspec.package = 'luawt-pruned'
+    for _, module in pairs(rockspec.build.modules) do
+        if type(module) == 'table' then
+            module.sources = pruneSources(module.sources, is_module, kept)
+            module.defines = module.defines or {}
+            table.insert(module.defines, 'LUAWT_PRUNED')
+        end
+    end
+    local fields = {
+        'package', 'version', 'source', 'description',
+        'dependencies', 'external_dependencies', 'build',
+    }
+    local out = {
+        '-- Generated by tools/prune.lua from ' .. ROCKSPEC,
+        '',
+    }
+    for _, field in ipairs(fields) do
+        table.insert(out, ('%s = %s'):format(
+            field, serialize(rockspec[field], '')))
+    end
+    writeFile(PRUNED_ROCKSPEC, table.concat(out, '\n') .. '\n')
+end
+
+local function writeModules(modules, kept)
+    local out = {
+        '// Generated by tools/prune.lua, included by init.cpp',
+    }
+    for _, name in ipairs(modules) do
+        if kept[name] then
+            table.insert(out, ('    MODULE(%s),'):format(name))
+        end
+    end
+    writeFile(PRUNED_MODULES, table.concat(out, '\n') .. '\n')
+end
+
+local function main()
+    local modules = widgetModules()
+    local is_module = {}
+    for _, name in ipairs(modules) do
+        is_module[name] = true
+    end
+    local kept = closure(parseArgs(is_module), is_module)
+    writeModules(modules, kept)
+    writeRockspec(is_module, kept)
+    local names = {}
+    for _, name in ipairs(modules) do
+        if kept[name] then
+            table.insert(names, name)
+        end
+    end
+    print(('%d of %d classes: %s'):format(
+        #names, #modules, table.concat(names, ' ')))
+end
+
+main()